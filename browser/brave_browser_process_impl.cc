@@ -113,6 +113,17 @@ ProfileManager* BraveBrowserProcessImpl::profile_manager() {
   return profile_manager_.get();
 }
 
+#if !defined(OS_ANDROID)
+void BraveBrowserProcessImpl::StartTearDown() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // P3A batches its local state writes, they have to land before the final
+  // commit done by the base class.
+  if (brave_p3a_service_)
+    brave_p3a_service_->Flush();
+  BrowserProcessImpl::StartTearDown();
+}
+#endif
+
 void BraveBrowserProcessImpl::StartBraveServices() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
@@ -65,6 +65,11 @@ class BraveBrowserProcessImpl : public BrowserProcessImpl {
 
   ProfileManager* profile_manager() override;
 
+#if !defined(OS_ANDROID)
+  // BrowserProcessImpl overrides:
+  void StartTearDown() override;
+#endif
+
   void StartBraveServices();
   brave_shields::AdBlockService* ad_block_service();
   brave_shields::AdBlockCustomFiltersService* ad_block_custom_filters_service();
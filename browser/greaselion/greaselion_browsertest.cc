@@ -3,6 +3,8 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <vector>
+
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/task/post_task.h"
@@ -18,14 +20,19 @@
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test_utils.h"
+#include "extensions/browser/extension_registry.h"
 #include "net/dns/mock_host_resolver.h"
 
 using brave_rewards::RewardsService;
 using brave_rewards::RewardsServiceFactory;
+using extensions::Extension;
 using extensions::ExtensionBrowserTest;
+using extensions::ExtensionRegistry;
 using greaselion::GreaselionDownloadService;
 using greaselion::GreaselionService;
 using greaselion::GreaselionServiceFactory;
+using greaselion::REWARDS;
+using greaselion::TWITTER_TIPS;
 
 const char kTestDataDirectory[] = "greaselion-data";
 const char kEmbeddedTestServerDirectory[] = "greaselion";
@@ -120,6 +127,22 @@ class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
     g_brave_browser_process->greaselion_download_service()->rules()->clear();
   }
 
+  std::string NavigateAndGetTitle(const std::string& host) {
+    GURL url = embedded_test_server()->GetURL(host, "/simple.html");
+    ui_test_utils::NavigateToURL(browser(), url);
+    content::WebContents* contents =
+        browser()->tab_strip_model()->GetActiveWebContents();
+    EXPECT_TRUE(content::WaitForLoadStop(contents));
+    EXPECT_EQ(url, contents->GetURL());
+    std::string title;
+    EXPECT_TRUE(
+        ExecuteScriptAndExtractString(contents,
+                                      "window.domAutomationController.send("
+                                      "document.title)",
+                                      &title));
+    return title;
+  }
+
   void SetRewardsEnabled(bool enabled) {
     RewardsService* rewards_service =
         RewardsServiceFactory::GetForProfile(profile());
@@ -199,3 +222,32 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, ScriptInjectionWithPrecondition) {
   // Greaselion rule is active
   EXPECT_EQ(title, "Altered");
 }
+
+// Toggling features back-to-back queues an update behind the running one.
+// Both end up installed and the extensions of unchanged rules are kept.
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, BackToBackFeatureUpdates) {
+  ASSERT_TRUE(InstallMockExtension());
+  EXPECT_EQ(NavigateAndGetTitle("pre1.example.com"), "OK");
+  EXPECT_EQ(NavigateAndGetTitle("pre2.example.com"), "OK");
+
+  // Hold references so a reloaded extension can't reuse an old address.
+  ExtensionRegistry* registry = ExtensionRegistry::Get(profile());
+  std::vector<scoped_refptr<const Extension>> extensions_before;
+  for (const auto& extension : registry->enabled_extensions())
+    extensions_before.push_back(extension);
+
+  GreaselionService* greaselion_service =
+      GreaselionServiceFactory::GetForBrowserContext(profile());
+  greaselion_service->SetFeatureEnabled(REWARDS, true);
+  greaselion_service->SetFeatureEnabled(TWITTER_TIPS, true);
+  GreaselionServiceWaiter(greaselion_service).Wait();
+
+  EXPECT_EQ(extensions_before.size() + 2,
+            registry->enabled_extensions().size());
+  for (const auto& extension : extensions_before) {
+    EXPECT_EQ(extension.get(),
+              registry->enabled_extensions().GetByID(extension->id()));
+  }
+  EXPECT_EQ(NavigateAndGetTitle("pre1.example.com"), "Altered");
+  EXPECT_EQ(NavigateAndGetTitle("pre2.example.com"), "Altered");
+}
@@ -9,6 +9,8 @@
 
 #include "brave/browser/importer/brave_in_process_importer_bridge.h"
 #include "chrome/browser/importer/external_process_importer_client.h"
+#include "chrome/common/importer/importer_url_row.h"
+#include "components/favicon_base/favicon_usage_data.h"
 #include "net/cookies/canonical_cookie.h"
 
 struct BraveStats;
@@ -26,6 +28,13 @@ class BraveExternalProcessImporterClient : public ExternalProcessImporterClient
   // Called by the ExternalProcessImporterHost on import cancel.
   void Cancel();
 
+  void OnHistoryImportStart(uint32_t total_history_rows_count) override;
+  void OnHistoryImportGroup(
+      const std::vector<ImporterURLRow>& history_rows_group,
+      int visit_source) override;
+  void OnFaviconsImportStart(uint32_t total_favicons_count) override;
+  void OnFaviconsImportGroup(
+      const favicon_base::FaviconUsageDataList& favicons_group) override;
   void OnCookiesImportStart(
       uint32_t total_cookies_count) override;
   void OnCookiesImportGroup(
@@ -46,6 +55,15 @@ class BraveExternalProcessImporterClient : public ExternalProcessImporterClient
   // Total number of cookies to import.
   size_t total_cookies_count_;
 
+  // Number of rows in the history chunk being received. Importers send
+  // their history in chunks, each one is written as soon as it is complete.
+  size_t total_history_rows_count_;
+  std::vector<ImporterURLRow> history_rows_;
+
+  // Same as above, for the favicons chunk being received.
+  size_t total_favicons_count_;
+  favicon_base::FaviconUsageDataList favicons_;
+
   scoped_refptr<BraveInProcessImporterBridge> bridge_;
 
   std::vector<net::CanonicalCookie> cookies_;
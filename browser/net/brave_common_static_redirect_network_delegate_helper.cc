@@ -9,6 +9,8 @@
 #include <string>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/net/static_redirect_table.h"
 #include "brave/common/network_constants.h"
 #include "components/component_updater/component_updater_url_constants.h"
 #include "extensions/buildflags/buildflags.h"
@@ -20,27 +22,59 @@
 
 namespace brave {
 
-// Update server checks happen from the profile context for admin policy
-// installed extensions. Update server checks happen from the system context for
-// normal update operations.
-bool IsUpdaterURL(const GURL& gurl) {
-  static std::vector<URLPattern> updater_patterns(
-      {URLPattern(URLPattern::SCHEME_HTTPS,
-                  std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
-       URLPattern(
-           URLPattern::SCHEME_HTTP,
-           std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+namespace {
+
+GURL RedirectUpdater(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetQueryStr(request_url.query_piece());
+  return GURL(kBraveUpdatesExtensionsEndpoint).ReplaceComponents(replacements);
+}
+
+GURL RedirectChromeCast(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr(kBraveRedirectorProxy);
+  return request_url.ReplaceComponents(replacements);
+}
+
+GURL RedirectClients4(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr(kBraveClients4Proxy);
+  return request_url.ReplaceComponents(replacements);
+}
+
+const StaticRedirectTable& GetCommonStaticRedirectTable() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  static const base::NoDestructor<StaticRedirectTable> table(
+      std::vector<StaticRedirectTable::Rule>({
+          // Update server checks happen from the profile context for admin
+          // policy installed extensions. Update server checks happen from the
+          // system context for normal update operations.
+          {URLPattern(
+               URLPattern::SCHEME_HTTPS,
+               std::string(component_updater::kUpdaterJSONDefaultUrl) + "*"),
+           StaticRedirectTable::MATCH_URL, &RedirectUpdater},
+          {URLPattern(
+               URLPattern::SCHEME_HTTP,
+               std::string(component_updater::kUpdaterJSONFallbackUrl) + "*"),
+           StaticRedirectTable::MATCH_URL, &RedirectUpdater},
 #if BUILDFLAG(ENABLE_EXTENSIONS)
-       URLPattern(
-           URLPattern::SCHEME_HTTPS,
-           std::string(extension_urls::kChromeWebstoreUpdateURL) + "*")
+          {URLPattern(
+               URLPattern::SCHEME_HTTPS,
+               std::string(extension_urls::kChromeWebstoreUpdateURL) + "*"),
+           StaticRedirectTable::MATCH_URL, &RedirectUpdater},
 #endif
-  });
-  return std::any_of(
-      updater_patterns.begin(), updater_patterns.end(),
-      [&gurl](URLPattern pattern) { return pattern.MatchesURL(gurl); });
+          {URLPattern(kHttpOrHttps, kChromeCastPrefix),
+           StaticRedirectTable::MATCH_URL, &RedirectChromeCast},
+          {URLPattern(kHttpOrHttps, kClients4Prefix),
+           StaticRedirectTable::MATCH_HOST, &RedirectClients4},
+      }));
+  return *table;
 }
 
+}  // namespace
+
 int OnBeforeURLRequest_CommonStaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -57,34 +91,7 @@ int OnBeforeURLRequest_CommonStaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
   DCHECK(new_url);
-
-  GURL::Replacements replacements;
-  static URLPattern chromecast_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kChromeCastPrefix);
-  static URLPattern clients4_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kClients4Prefix);
-
-  if (IsUpdaterURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    *new_url = GURL(kBraveUpdatesExtensionsEndpoint)
-                            .ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (chromecast_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveRedirectorProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (clients4_pattern.MatchesHost(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveClients4Proxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
+  GetCommonStaticRedirectTable().GetRedirect(request_url, new_url);
   return net::OK;
 }
 
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/containers/span.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
@@ -42,57 +43,90 @@
 #include "brave/browser/net/brave_translate_redirect_network_delegate_helper.h"
 #endif
 
-BraveRequestHandler::BraveRequestHandler() {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  SetupCallbacks();
-  // Initialize the preference change registrar.
-  InitPrefChangeRegistrar();
-}
-
-BraveRequestHandler::~BraveRequestHandler() = default;
-
-void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+namespace {
 
-  callback = base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
+// All helpers are invoked through the same signature, the extra arguments of
+// the start transaction and headers received hooks are already stored in
+// |ctx|.
+using HelperStage = int (*)(const brave::ResponseCallback& next_callback,
+                            std::shared_ptr<brave::BraveRequestInfo> ctx);
 
-  callback = base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+template <int (*helper)(net::HttpRequestHeaders* headers,
+                        const brave::ResponseCallback& next_callback,
+                        std::shared_ptr<brave::BraveRequestInfo> ctx)>
+int StartTransactionStage(const brave::ResponseCallback& next_callback,
+                          std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return helper(ctx->headers, next_callback, ctx);
+}
 
-  callback = base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+template <int (*helper)(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
+    GURL* allowed_unsafe_redirect_url,
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx)>
+int HeadersReceivedStage(const brave::ResponseCallback& next_callback,
+                         std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return helper(ctx->original_response_headers, ctx->override_response_headers,
+                ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+}
+#endif
 
+constexpr HelperStage kBeforeURLRequestStages[] = {
+    brave::OnBeforeURLRequest_SiteHacksWork,
+    brave::OnBeforeURLRequest_AdBlockTPPreWork,
+    brave::OnBeforeURLRequest_HttpsePreFileWork,
+    brave::OnBeforeURLRequest_CommonStaticRedirectWork,
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
-  callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+    brave_rewards::OnBeforeURLRequest,
 #endif
-
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+    brave::OnBeforeURLRequest_TranslateRedirectWork,
 #endif
+};
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
-
+constexpr HelperStage kBeforeStartTransactionStages[] = {
+    StartTransactionStage<brave::OnBeforeStartTransaction_SiteHacksWork>,
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::Bind(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+    StartTransactionStage<brave::OnBeforeStartTransaction_ReferralsWork>,
+#endif
+};
+
+#if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
+constexpr HelperStage kHeadersReceivedStages[] = {
+    HeadersReceivedStage<webtorrent::OnHeadersReceived_TorrentRedirectWork>,
+};
 #endif
 
+base::span<const HelperStage> GetStages(
+    brave::BraveNetworkDelegateEventType event_type) {
+  switch (event_type) {
+    case brave::kOnBeforeRequest:
+      return kBeforeURLRequestStages;
+    case brave::kOnBeforeStartTransaction:
+      return kBeforeStartTransactionStages;
+    case brave::kOnHeadersReceived:
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::Bind(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+      return kHeadersReceivedStages;
+#else
+      return {};
 #endif
+    default:
+      return {};
+  }
 }
 
+}  // namespace
+
+BraveRequestHandler::BraveRequestHandler() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Initialize the preference change registrar.
+  InitPrefChangeRegistrar();
+}
+
+BraveRequestHandler::~BraveRequestHandler() = default;
+
 void BraveRequestHandler::InitPrefChangeRegistrar() {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
@@ -125,30 +159,28 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty()) {
+  if (GetStages(brave::kOnBeforeRequest).empty()) {
     return net::OK;
   }
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
   callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     net::HttpRequestHeaders* headers) {
-  if (before_start_transaction_callbacks_.empty()) {
+  if (GetStages(brave::kOnBeforeStartTransaction).empty()) {
     return net::OK;
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
   ctx->referral_headers_list = referral_headers_list_.get();
   callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -163,7 +195,7 @@ int BraveRequestHandler::OnHeadersReceived(
         original_response_headers, override_response_headers);
   }
 
-  if (headers_received_callbacks_.empty()) {
+  if (GetStages(brave::kOnHeadersReceived).empty()) {
     return net::OK;
   }
 
@@ -173,8 +205,7 @@ int BraveRequestHandler::OnHeadersReceived(
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
 
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartCallbacks(ctx);
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
@@ -189,14 +220,38 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
     int rv) {
   std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
       callbacks_.find(request_identifier);
-  // We intentionally do the async call to maintain the proper flow
-  // of URLLoader callbacks.
+  if (it == callbacks_.end())
+    return;
+  // This is only reached after at least one helper went asynchronous, so the
+  // caller has already seen ERR_IO_PENDING and it is safe to resume it from
+  // the current task.
+  net::CompletionOnceCallback callback = std::move(it->second);
+  callbacks_.erase(it);
+  std::move(callback).Run(rv);
+}
+
+int BraveRequestHandler::StartCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  int rv = RunCallbacks(ctx);
+  if (rv == net::ERR_IO_PENDING)
+    return rv;
+
+  // Every helper finished synchronously (the common case), so hand the result
+  // straight back to the caller instead of posting the completion callback.
+  // Results that callers only expect asynchronously keep the old behaviour.
+  if (rv == net::OK || rv == net::ERR_BLOCKED_BY_CLIENT) {
+    callbacks_.erase(ctx->request_identifier);
+    return rv;
+  }
+
+  auto it = callbacks_.find(ctx->request_identifier);
+  DCHECK(it != callbacks_.end());
   base::PostTaskWithTraits(FROM_HERE, {content::BrowserThread::UI},
                            base::BindOnce(std::move(it->second), rv));
+  callbacks_.erase(it);
+  return net::ERR_IO_PENDING;
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
 void BraveRequestHandler::RunNextCallback(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -205,66 +260,31 @@ void BraveRequestHandler::RunNextCallback(
     return;
   }
 
-  // Continue processing callbacks until we hit one that returns PENDING
-  int rv = net::OK;
+  int rv = RunCallbacks(ctx);
+  if (rv != net::ERR_IO_PENDING)
+    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+}
 
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    while (before_start_transaction_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnHeadersReceived) {
-    while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
+int BraveRequestHandler::RunCallbacks(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  const base::span<const HelperStage> stages = GetStages(ctx->event_type);
+  // A single resume callback is shared by all stages of this run, it is only
+  // invoked by a stage that returned ERR_IO_PENDING.
+  const brave::ResponseCallback next_callback = base::BindRepeating(
+      &BraveRequestHandler::RunNextCallback, weak_factory_.GetWeakPtr(), ctx);
+
+  // Continue processing stages until we hit one that returns PENDING
+  int rv = net::OK;
+  while (ctx->next_url_request_index < stages.size()) {
+    rv = stages[ctx->next_url_request_index++](next_callback, ctx);
+    if (rv != net::OK)
+      break;
   }
 
   if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
+    return rv;
   }
 
   if (ctx->event_type == brave::kOnBeforeRequest) {
@@ -275,11 +295,9 @@ void BraveRequestHandler::RunNextCallback(
     }
     if (ctx->blocked_by == brave::kAdBlocked) {
       if (ctx->cancel_request_explicitly) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_ABORTED);
-        return;
+        return net::ERR_ABORTED;
       }
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return rv;
 }
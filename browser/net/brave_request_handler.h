@@ -9,7 +9,6 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <vector>
 
 #include "brave/browser/net/url_context.h"
 #include "content/public/browser/browser_thread.h"
@@ -46,18 +45,17 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
-  void SetupCallbacks();
   void InitPrefChangeRegistrar();
   void OnReferralHeadersChanged();
   void OnPreferenceChanged(const std::string& pref_name);
   void UpdateAdBlockFromPref(const std::string& pref_name);
 
+  // Runs the helper chain for a new event. Returns the result directly when
+  // every helper completed synchronously, otherwise ERR_IO_PENDING.
+  int StartCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Resumes the helper chain after an asynchronous helper has finished.
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
-
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
-      before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
+  int RunCallbacks(std::shared_ptr<brave::BraveRequestInfo> ctx);
 
   // TODO(iefremov): actually, we don't have to keep the list here, since
   // it is global for the whole browser and could live a singletonce in the
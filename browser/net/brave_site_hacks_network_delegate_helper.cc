@@ -9,10 +9,13 @@
 #include <string>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
+#include "base/optional.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
@@ -24,7 +27,6 @@
 #include "content/public/common/referrer.h"
 #include "extensions/common/url_pattern.h"
 #include "net/url_request/url_request.h"
-#include "third_party/re2/src/re2/re2.h"
 
 using content::BrowserThread;
 using content::Referrer;
@@ -33,41 +35,66 @@ namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>({"fbclid", "gclid", "msclkid", "mc_eid"}), "|"));
+// Orders strings ignoring ASCII case. Transparent, so that sets using it can
+// be searched with a base::StringPiece.
+struct CaseInsensitiveCompare {
+  using is_transparent = void;
+
+  bool operator()(base::StringPiece a, base::StringPiece b) const {
+    return base::CompareCaseInsensitiveASCII(a, b) < 0;
+  }
+};
+
+using QueryParameterSet = base::flat_set<std::string, CaseInsensitiveCompare>;
+
+// Query parameters which are removed from top-level navigations when they
+// have a value.
+const QueryParameterSet& GetQueryStringTrackers() {
+  static const base::NoDestructor<QueryParameterSet> trackers(
+      std::vector<std::string>({"fbclid", "gclid", "msclkid", "mc_eid"}));
   return *trackers;
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+bool IsQueryStringTracker(base::StringPiece parameter) {
+  const size_t separator = parameter.find('=');
+  if (separator == base::StringPiece::npos ||
+      separator + 1 == parameter.length()) {
+    return false;
+  }
+  return base::Contains(GetQueryStringTrackers(),
+                        parameter.substr(0, separator));
+}
+
+// Returns |query| without its tracking parameters, or base::nullopt when it
+// doesn't have any. Other parameters and separators are kept untouched.
+base::Optional<std::string> StripQueryStringTrackers(base::StringPiece query) {
+  base::Optional<std::string> new_query;
+  size_t kept_count = 0;
+  size_t start = 0;
+  while (start <= query.length()) {
+    size_t end = query.find('&', start);
+    if (end == base::StringPiece::npos)
+      end = query.length();
+    const base::StringPiece parameter = query.substr(start, end - start);
+
+    if (IsQueryStringTracker(parameter)) {
+      // Only copy the query once something needs to be removed.
+      if (!new_query) {
+        new_query.emplace(
+            start > 0 ? query.substr(0, start - 1) : base::StringPiece());
+      }
+    } else {
+      if (new_query) {
+        if (kept_count > 0)
+          new_query->push_back('&');
+        parameter.AppendToString(&*new_query);
+      }
+      ++kept_count;
+    }
+    start = end + 1;
+  }
+  return new_query;
+}
 
 bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
   GURL target_origin = ctx->request_url.GetOrigin();
@@ -93,20 +120,16 @@ void ApplyPotentialQueryStringFilter(const GURL& request_url,
                                      std::string* new_url_spec) {
   DCHECK(new_url_spec);
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
-  std::string new_query = request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
+  base::Optional<std::string> new_query =
+      StripQueryStringTrackers(request_url.query_piece());
+
+  if (new_query) {
     url::Replacements<char> replacements;
-    if (new_query.empty()) {
+    if (new_query->empty()) {
       replacements.ClearQuery();
     } else {
-      replacements.SetQuery(new_query.c_str(),
-                            url::Component(0, new_query.size()));
+      replacements.SetQuery(new_query->c_str(),
+                            url::Component(0, new_query->size()));
     }
     *new_url_spec = request_url.ReplaceComponents(replacements).spec();
   }
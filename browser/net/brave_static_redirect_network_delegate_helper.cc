@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 
+#include "base/no_destructor.h"
+#include "brave/browser/net/static_redirect_table.h"
 #include "brave/browser/translate/buildflags/buildflags.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/translate_network_constants.h"
@@ -15,6 +17,97 @@
 
 namespace brave {
 
+namespace {
+
+GURL RedirectGeoLocation(const GURL& request_url) {
+  return GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+}
+
+GURL RedirectSafeBrowsing(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
+  return request_url.ReplaceComponents(replacements);
+}
+
+GURL RedirectSafeBrowsingFileCheck(const GURL& request_url) {
+  // TODO(@fmarier): Re-enable download protection once we have
+  // truncated the list of metadata that it sends to the server
+  // (brave/brave-browser#6267).
+  //
+  // GURL::Replacements replacements;
+  // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
+  // return request_url.ReplaceComponents(replacements);
+  return GURL();
+}
+
+GURL RedirectCRXDownload(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr("crxdownload.brave.com");
+  return request_url.ReplaceComponents(replacements);
+}
+
+GURL RedirectAutofill(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr(kBraveStaticProxy);
+  return request_url.ReplaceComponents(replacements);
+}
+
+GURL RedirectCRLSet(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetSchemeStr("https");
+  replacements.SetHostStr("crlsets.brave.com");
+  return request_url.ReplaceComponents(replacements);
+}
+
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+GURL RedirectTranslate(const GURL& request_url) {
+  GURL::Replacements replacements;
+  replacements.SetQueryStr(request_url.query_piece());
+  replacements.SetPathStr(request_url.path_piece());
+  return GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
+}
+
+GURL RedirectTranslateLanguage(const GURL& request_url) {
+  return GURL(kBraveTranslateLanguageEndpoint);
+}
+#endif
+
+const StaticRedirectTable& GetStaticRedirectTable() {
+  const int kHttpOrHttps = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+  static const base::NoDestructor<StaticRedirectTable> table(
+      std::vector<StaticRedirectTable::Rule>({
+          {URLPattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern),
+           StaticRedirectTable::MATCH_URL, &RedirectGeoLocation},
+          {URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingPrefix),
+           StaticRedirectTable::MATCH_HOST, &RedirectSafeBrowsing},
+          {URLPattern(URLPattern::SCHEME_HTTPS, kSafeBrowsingFileCheckPrefix),
+           StaticRedirectTable::MATCH_HOST, &RedirectSafeBrowsingFileCheck},
+          {URLPattern(kHttpOrHttps, kCRXDownloadPrefix),
+           StaticRedirectTable::MATCH_URL, &RedirectCRXDownload},
+          {URLPattern(URLPattern::SCHEME_HTTPS, kAutofillPrefix),
+           StaticRedirectTable::MATCH_URL, &RedirectAutofill},
+          {URLPattern(kHttpOrHttps, kCRLSetPrefix1),
+           StaticRedirectTable::MATCH_URL, &RedirectCRLSet},
+          {URLPattern(kHttpOrHttps, kCRLSetPrefix2),
+           StaticRedirectTable::MATCH_URL, &RedirectCRLSet},
+          {URLPattern(kHttpOrHttps, kCRLSetPrefix3),
+           StaticRedirectTable::MATCH_URL, &RedirectCRLSet},
+          {URLPattern(kHttpOrHttps, kCRLSetPrefix4),
+           StaticRedirectTable::MATCH_URL, &RedirectCRLSet},
+#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
+          {URLPattern(URLPattern::SCHEME_HTTPS, kTranslateElementJSPattern),
+           StaticRedirectTable::MATCH_URL, &RedirectTranslate},
+          {URLPattern(URLPattern::SCHEME_HTTPS, kTranslateLanguagePattern),
+           StaticRedirectTable::MATCH_URL, &RedirectTranslateLanguage},
+#endif
+      }));
+  return *table;
+}
+
+}  // namespace
+
 int OnBeforeURLRequest_StaticRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
@@ -30,107 +123,8 @@ int OnBeforeURLRequest_StaticRedirectWork(
 int OnBeforeURLRequest_StaticRedirectWorkForGURL(
     const GURL& request_url,
     GURL* new_url) {
-  GURL::Replacements replacements;
-  static URLPattern geo_pattern(URLPattern::SCHEME_HTTPS, kGeoLocationsPattern);
-  static URLPattern safeBrowsing_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingPrefix);
-  static URLPattern safebrowsingfilecheck_pattern(URLPattern::SCHEME_HTTPS,
-                                         kSafeBrowsingFileCheckPrefix);
-  static URLPattern crlSet_pattern1(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix1);
-  static URLPattern crlSet_pattern2(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix2);
-  static URLPattern crlSet_pattern3(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix3);
-  static URLPattern crlSet_pattern4(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRLSetPrefix4);
-  static URLPattern crxDownload_pattern(
-      URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS, kCRXDownloadPrefix);
-  static URLPattern autofill_pattern(
-      URLPattern::SCHEME_HTTPS, kAutofillPrefix);
-
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  static URLPattern translate_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateElementJSPattern);
-  static URLPattern translate_language_pattern(URLPattern::SCHEME_HTTPS,
-      kTranslateLanguagePattern);
-#endif
-  if (geo_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(GOOGLEAPIS_ENDPOINT GOOGLEAPIS_API_KEY);
+  if (GetStaticRedirectTable().GetRedirect(request_url, new_url))
     return net::OK;
-  }
-
-  if (safeBrowsing_pattern.MatchesHost(request_url)) {
-    replacements.SetHostStr(SAFEBROWSING_ENDPOINT);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (safebrowsingfilecheck_pattern.MatchesHost(request_url)) {
-    // TODO(@fmarier): Re-enable download protection once we have
-    // truncated the list of metadata that it sends to the server
-    // (brave/brave-browser#6267).
-    //
-    // replacements.SetHostStr(kBraveSafeBrowsingFileCheckProxy);
-    // *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crxDownload_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crxdownload.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (autofill_pattern.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr(kBraveStaticProxy);
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern1.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern2.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern3.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (crlSet_pattern4.MatchesURL(request_url)) {
-    replacements.SetSchemeStr("https");
-    replacements.SetHostStr("crlsets.brave.com");
-    *new_url = request_url.ReplaceComponents(replacements);
-    return net::OK;
-  }
-#if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
-  if (translate_pattern.MatchesURL(request_url)) {
-    replacements.SetQueryStr(request_url.query_piece());
-    replacements.SetPathStr(request_url.path_piece());
-    *new_url =
-      GURL(kBraveTranslateEndpoint).ReplaceComponents(replacements);
-    return net::OK;
-  }
-
-  if (translate_language_pattern.MatchesURL(request_url)) {
-    *new_url = GURL(kBraveTranslateLanguageEndpoint);
-    return net::OK;
-  }
-#endif
 
 #if !defined(NDEBUG)
   GURL gurl = request_url;
@@ -28,6 +28,21 @@ TEST(BraveStaticRedirectNetworkDelegateHelperTest, NoModifyTypicalURL) {
   EXPECT_EQ(rc, net::OK);
 }
 
+TEST(BraveStaticRedirectNetworkDelegateHelperTest, NoModifyLookalikeHosts) {
+  const GURL urls[] = {
+      GURL("https://safebrowsing.googleapis.com.example.com/v4/"),
+      GURL("https://www.googleapis.com.example.com/geolocation/v1/geolocate"),
+      GURL("https://example.com/safebrowsing.googleapis.com/"),
+  };
+  for (const GURL& url : urls) {
+    auto request_info = std::make_shared<brave::BraveRequestInfo>(url);
+    int rc =
+        OnBeforeURLRequest_StaticRedirectWork(ResponseCallback(), request_info);
+    EXPECT_TRUE(request_info->new_url_spec.empty()) << url;
+    EXPECT_EQ(rc, net::OK);
+  }
+}
+
 TEST(BraveStaticRedirectNetworkDelegateHelperTest, ModifyGeoURL) {
   const GURL url(
       "https://www.googleapis.com/geolocation/v1/geolocate?key=2_3_5_7");
@@ -0,0 +1,40 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/static_redirect_table.h"
+
+#include <utility>
+
+#include "base/logging.h"
+
+namespace brave {
+
+StaticRedirectTable::StaticRedirectTable(std::vector<Rule> rules)
+    : rules_(std::move(rules)) {
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    DCHECK(rules_[i].redirect);
+    index_.Add(rules_[i].pattern, i);
+  }
+}
+
+StaticRedirectTable::~StaticRedirectTable() = default;
+
+bool StaticRedirectTable::GetRedirect(const GURL& request_url,
+                                      GURL* new_url) const {
+  DCHECK(new_url);
+  for (size_t id : index_.GetCandidateIds(request_url)) {
+    const Rule& rule = rules_[id];
+    const bool matches = rule.match_type == MATCH_HOST
+                             ? rule.pattern.MatchesHost(request_url)
+                             : rule.pattern.MatchesURL(request_url);
+    if (matches) {
+      *new_url = rule.redirect(request_url);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace brave
@@ -0,0 +1,57 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
+#define BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/url_pattern_host_index.h"
+#include "extensions/common/url_pattern.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+// Static redirect rules, indexed by the host of their pattern so that a
+// request only runs the rules which can apply to its host. Rules are tried
+// in the order they were added and the first matching one wins.
+class StaticRedirectTable {
+ public:
+  // Returns the URL to redirect |request_url| to, or an empty URL to leave
+  // the request alone.
+  using RedirectFunction = GURL (*)(const GURL& request_url);
+
+  enum MatchType {
+    // The rule applies when its pattern matches the whole URL.
+    MATCH_URL,
+    // The rule applies when its pattern matches the host of the URL.
+    MATCH_HOST,
+  };
+
+  struct Rule {
+    URLPattern pattern;
+    MatchType match_type;
+    RedirectFunction redirect;
+  };
+
+  explicit StaticRedirectTable(std::vector<Rule> rules);
+  ~StaticRedirectTable();
+
+  // Returns true if a rule applies to |request_url|, and sets |new_url| to
+  // its redirect.
+  bool GetRedirect(const GURL& request_url, GURL* new_url) const;
+
+ private:
+  const std::vector<Rule> rules_;
+  // Ids are indices in |rules_|.
+  brave_shields::URLPatternHostIndex index_;
+
+  DISALLOW_COPY_AND_ASSIGN(StaticRedirectTable);
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BROWSER_NET_STATIC_REDIRECT_TABLE_H_
@@ -12,6 +12,7 @@
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
 
 namespace brave {
@@ -91,15 +92,17 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                               .GetOrigin();
   }
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(profile, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(profile, ctx->tab_origin) ==
-                   brave_shields::ControlType::ALLOW;
+  ctx->shields_settings = brave_shields::BraveShieldsWebContentsObserver::
+      GetShieldsSettingsForFrame(
+          HostContentSettingsMapFactory::GetForProfile(
+              Profile::FromBrowserContext(browser_context)),
+          ctx->tab_origin, ctx->render_process_id, ctx->render_frame_id,
+          ctx->frame_tree_node_id);
+  ctx->allow_brave_shields = ctx->shields_settings->brave_shields_enabled;
+  ctx->allow_ads = ctx->shields_settings->allow_ads;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(profile, ctx->tab_origin);
-  ctx->allow_referrers =
-      brave_shields::AllowReferrers(profile, ctx->tab_origin);
+      ctx->shields_settings->allow_http_upgradable_resource;
+  ctx->allow_referrers = ctx->shields_settings->allow_referrers;
   ctx->upload_data = GetUploadData(request);
 }
 
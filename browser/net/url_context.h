@@ -10,12 +10,17 @@
 #include <set>
 #include <string>
 
+#include "base/memory/ref_counted.h"
 #include "content/public/common/resource_type.h"
 #include "net/url_request/url_request.h"
 #include "url/gurl.h"
 
 class BraveRequestHandler;
 
+namespace brave_shields {
+struct ShieldsSettings;
+}
+
 namespace content {
 class BrowserContext;
 }
@@ -71,6 +76,9 @@ struct BraveRequestInfo {
   bool allow_http_upgradable_resource = false;
   bool allow_referrers = false;
   bool is_webtorrent_disabled = false;
+  // Shields settings shared by all requests of the frame tree, the allow_*
+  // flags above are filled from it.
+  scoped_refptr<const brave_shields::ShieldsSettings> shields_settings;
   int render_process_id = 0;
   int render_frame_id = 0;
   int frame_tree_node_id = 0;
@@ -5,6 +5,8 @@
 
 #include "components/sync_bookmarks/bookmark_change_processor.h"
 
+#include <vector>
+
 #include "brave/components/brave_sync/syncer_helper.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/sync/syncable/base_transaction.h"
@@ -66,6 +68,24 @@ void BookmarkChangeProcessor::MoveSyncNode(
   }
 }
 
+void BookmarkChangeProcessor::RepositionRespectOrder(
+    BookmarkModel* model,
+    const base::flat_set<const BookmarkNode*>& parents,
+    const syncer::BaseTransaction* trans) {
+  // Sort the children of each affected parent once, instead of looking up
+  // the position of every repositioned node separately.
+  for (const BookmarkNode* parent : parents) {
+    const std::vector<const BookmarkNode*> sorted =
+        brave_sync::GetChildrenSortedByOrder(parent);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+      if (parent->children()[i].get() == sorted[i])
+        continue;
+      model->Move(sorted[i], parent, i);
+      MoveSyncNode(i, sorted[i], trans);
+    }
+  }
+}
+
 }  // namespace sync_bookmarks
 
 #define BRAVE_BOOKMARK_CHANGE_PROCESSOR_BOOKMARK_NODE_FAVICON_CHANGED \
@@ -84,13 +104,14 @@ void BookmarkChangeProcessor::MoveSyncNode(
   brave_sync::AddBraveMetaInfo(child, model);              \
   SetSyncNodeMetaInfo(child, &sync_child);
 
-#define BRAVE_BOOKMARK_CHANGE_PROCESSOR_APPLY_CHANGES_FROM_SYNC_MODEL   \
-  int new_index =                                                         \
-      brave_sync::GetIndexByCompareOrderStartFrom(parent, it->second, 0); \
-  if (it->first != new_index) {                                           \
-    model->Move(it->second, parent, new_index);                           \
-    MoveSyncNode(new_index, it->second, trans);                           \
-  } else  // NOLINT
+#define BRAVE_BOOKMARK_CHANGE_PROCESSOR_APPLY_CHANGES_FROM_SYNC_MODEL \
+  if (it == to_reposition.begin()) {                                  \
+    base::flat_set<const BookmarkNode*> parents;                      \
+    for (const auto& item : to_reposition)                            \
+      parents.insert(item.second->parent());                          \
+    RepositionRespectOrder(model, parents, trans);                    \
+    break;                                                            \
+  }
 
 #include "../../../../components/sync_bookmarks/bookmark_change_processor.cc"  // NOLINT
 #undef BRAVE_BOOKMARK_CHANGE_PROCESSOR_BOOKMARK_NODE_FAVICON_CHANGED
@@ -6,9 +6,15 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_SYNC_BOOKMARKS_BOOKMARK_CHANGE_PROCESSOR_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_SYNC_BOOKMARKS_BOOKMARK_CHANGE_PROCESSOR_H_
 
-#define BRAVE_BOOKMARK_CHANGE_PROCESSOR_H_                          \
-  void MoveSyncNode(int index, const bookmarks::BookmarkNode* node, \
-                    const syncer::BaseTransaction* trans);
+#include "base/containers/flat_set.h"
+
+#define BRAVE_BOOKMARK_CHANGE_PROCESSOR_H_                              \
+  void MoveSyncNode(int index, const bookmarks::BookmarkNode* node,     \
+                    const syncer::BaseTransaction* trans);              \
+  void RepositionRespectOrder(                                          \
+      bookmarks::BookmarkModel* model,                                  \
+      const base::flat_set<const bookmarks::BookmarkNode*>& parents,    \
+      const syncer::BaseTransaction* trans);
 
 #include "../../../../../components/sync_bookmarks/bookmark_change_processor.h"
 #undef BRAVE_BOOKMARK_CHANGE_PROCESSOR_H_
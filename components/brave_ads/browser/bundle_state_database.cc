@@ -8,11 +8,15 @@
 #include <stdint.h>
 
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
@@ -25,6 +29,16 @@ namespace {
 const int kCurrentVersionNumber = 2;
 const int kCompatibleVersionNumber = 2;
 
+// Formats |time| the way strftime('%Y-%m-%d %H:%M', datetime('now',
+// 'localtime')) does, so it compares to the stored timestamps like SQLite does.
+std::string GetLocalTimeString(base::Time time) {
+  base::Time::Exploded exploded;
+  time.LocalExplode(&exploded);
+  return base::StringPrintf("%04d-%02d-%02d %02d:%02d", exploded.year,
+                            exploded.month, exploded.day_of_month,
+                            exploded.hour, exploded.minute);
+}
+
 }  // namespace
 
 BundleStateDatabase::BundleStateDatabase(const base::FilePath& db_path) :
@@ -45,6 +59,7 @@ bool BundleStateDatabase::Init() {
     return true;
 
   initialized_ = false;
+  ads_for_category_.clear();
 
   if (db_.is_open()) {
     db_.Close();
@@ -99,20 +114,6 @@ bool BundleStateDatabase::CreateCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM category"));
-  return sql.Run();
-}
-
 
 bool BundleStateDatabase::CreateAdInfoTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -143,20 +144,6 @@ bool BundleStateDatabase::CreateAdInfoTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(
-      GetDB().GetCachedStatement(SQL_FROM_HERE, "DELETE FROM ad_info"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -183,20 +170,6 @@ bool BundleStateDatabase::CreateAdInfoCategoryTable() {
   return GetDB().Execute(sql.c_str());
 }
 
-bool BundleStateDatabase::TruncateAdInfoCategoryTable() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
-
-  sql::Statement sql(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "DELETE FROM ad_info_category"));
-  return sql.Run();
-}
-
 bool BundleStateDatabase::CreateAdInfoCategoryNameIndex() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -215,122 +188,233 @@ bool BundleStateDatabase::SaveBundleState(
   if (!initialized)
     return false;
 
+  ads_for_category_.clear();
+
+  // The rows of the new bundle. An ad is listed under each of its categories,
+  // but only needs to be written once per region.
+  std::set<std::string> categories;
+  AdInfoRows ad_infos;
+  AdInfoCategoryRows ad_info_categories;
+  for (const auto& category : bundle_state.categories) {
+    categories.insert(category.first);
+    for (const auto& ad_info : category.second) {
+      for (const auto& region : ad_info.regions)
+        ad_infos[std::make_pair(region, ad_info.uuid)] = &ad_info;
+      ad_info_categories.emplace(ad_info.uuid, category.first);
+    }
+  }
+
   if (!GetDB().BeginTransaction())
     return false;
 
-  // we are completely replacing here so first truncate all the tables
-  if (!TruncateAdInfoCategoryTable() ||
-      !TruncateAdInfoTable() ||
-      !TruncateCategoryTable()) {
+  // Rather than truncating the tables, only the rows which are gone are
+  // deleted and only new or changed rows are written, so that a catalog update
+  // which touches a few campaigns only writes those.
+  bool deleted_rows = false;
+  if (!DeleteRemovedAdInfoCategories(ad_info_categories, &deleted_rows) ||
+      !DeleteRemovedAdInfo(ad_infos, &deleted_rows) ||
+      !DeleteRemovedCategories(categories, &deleted_rows)) {
     GetDB().RollbackTransaction();
     return false;
   }
 
-  auto categories = bundle_state.categories;
-  for (std::map<std::string, std::vector<ads::AdInfo>>::iterator it =
-      categories.begin();  it != categories.end(); ++it) {
-    auto category = it->first;
+  for (const auto& category : categories) {
     if (!InsertOrUpdateCategory(category)) {
       GetDB().RollbackTransaction();
       return false;
     }
+  }
+
+  for (const auto& ad_info : ad_infos) {
+    if (!InsertOrUpdateAdInfo(*ad_info.second, ad_info.first.first)) {
+      GetDB().RollbackTransaction();
+      return false;
+    }
+  }
 
-    auto ads = it->second;
-    for (std::vector<ads::AdInfo>::iterator ad_it = ads.begin();
-        ad_it != ads.end(); ++ad_it) {
-      auto ad_info = *ad_it;
-      if (!InsertOrUpdateAdInfo(ad_info) ||
-          !InsertOrUpdateAdInfoCategory(ad_info, category)) {
-        GetDB().RollbackTransaction();
-        return false;
-      }
+  for (const auto& ad_info_category : ad_info_categories) {
+    if (!InsertOrUpdateAdInfoCategory(ad_info_category.first,
+                                      ad_info_category.second)) {
+      GetDB().RollbackTransaction();
+      return false;
     }
   }
 
   if (GetDB().CommitTransaction()) {
-    Vacuum();
+    // Only deletions leave free pages behind worth reclaiming.
+    if (deleted_rows)
+      Vacuum();
     return true;
   }
 
   return false;
 }
 
-bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
+bool BundleStateDatabase::DeleteRemovedCategories(
+    const std::set<std::string>& categories,
+    bool* deleted_rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  std::vector<std::string> removed_categories;
+  sql::Statement select_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE, "SELECT name FROM category"));
+  while (select_statement.Step()) {
+    std::string category = select_statement.ColumnString(0);
+    if (!categories.count(category))
+      removed_categories.push_back(std::move(category));
+  }
 
-  if (!initialized)
-    return false;
+  for (const auto& category : removed_categories) {
+    sql::Statement delete_statement(
+        GetDB().GetCachedStatement(SQL_FROM_HERE,
+            "DELETE FROM category WHERE name = ?"));
+    delete_statement.BindString(0, category);
+    if (!delete_statement.Run())
+      return false;
+    *deleted_rows = true;
+  }
 
-  sql::Statement ad_info_statement(
+  return true;
+}
+
+bool BundleStateDatabase::DeleteRemovedAdInfo(
+    const AdInfoRows& ad_infos,
+    bool* deleted_rows) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::vector<std::pair<std::string, std::string>> removed_ad_infos;
+  sql::Statement select_statement(
       GetDB().GetCachedStatement(SQL_FROM_HERE,
-          "INSERT OR REPLACE INTO category "
-          "(name) "
-          "VALUES (?)"));
+          "SELECT region, uuid FROM ad_info"));
+  while (select_statement.Step()) {
+    auto key = std::make_pair(select_statement.ColumnString(0),
+                              select_statement.ColumnString(1));
+    if (!ad_infos.count(key))
+      removed_ad_infos.push_back(std::move(key));
+  }
 
-  ad_info_statement.BindString(0, category);
+  for (const auto& ad_info : removed_ad_infos) {
+    sql::Statement delete_statement(
+        GetDB().GetCachedStatement(SQL_FROM_HERE,
+            "DELETE FROM ad_info WHERE region = ? AND uuid = ?"));
+    delete_statement.BindString(0, ad_info.first);
+    delete_statement.BindString(1, ad_info.second);
+    if (!delete_statement.Run())
+      return false;
+    *deleted_rows = true;
+  }
 
-  return ad_info_statement.Run();
+  return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfo(const ads::AdInfo& info) {
+bool BundleStateDatabase::DeleteRemovedAdInfoCategories(
+    const AdInfoCategoryRows& ad_info_categories,
+    bool* deleted_rows) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
-
-  if (!initialized)
-    return false;
+  std::vector<std::pair<std::string, std::string>> removed_ad_info_categories;
+  sql::Statement select_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "SELECT ad_info_uuid, category_name FROM ad_info_category"));
+  while (select_statement.Step()) {
+    auto key = std::make_pair(select_statement.ColumnString(0),
+                              select_statement.ColumnString(1));
+    if (!ad_info_categories.count(key))
+      removed_ad_info_categories.push_back(std::move(key));
+  }
 
-  for (auto it = info.regions.begin(); it != info.regions.end(); ++it) {
-    sql::Statement ad_info_statement(
+  for (const auto& ad_info_category : removed_ad_info_categories) {
+    sql::Statement delete_statement(
         GetDB().GetCachedStatement(SQL_FROM_HERE,
-            "INSERT OR REPLACE INTO ad_info "
-            "(creative_set_id, advertiser, notification_text, "
-            "notification_url, start_timestamp, end_timestamp, uuid, "
-            "campaign_id, daily_cap, per_day, total_max, region) "
-            "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?)"));
-
-    ad_info_statement.BindString(0, info.creative_set_id);
-    ad_info_statement.BindString(1, info.advertiser);
-    ad_info_statement.BindString(2, info.notification_text);
-    ad_info_statement.BindString(3, info.notification_url);
-    ad_info_statement.BindString(4, info.start_timestamp);
-    ad_info_statement.BindString(5, info.end_timestamp);
-    ad_info_statement.BindString(6, info.uuid);
-    ad_info_statement.BindString(7, info.campaign_id);
-    ad_info_statement.BindInt(8, info.daily_cap);
-    ad_info_statement.BindInt(9, info.per_day);
-    ad_info_statement.BindInt(10, info.total_max);
-    ad_info_statement.BindString(11, *it);
-    if (!ad_info_statement.Run()) {
+            "DELETE FROM ad_info_category "
+            "WHERE ad_info_uuid = ? AND category_name = ?"));
+    delete_statement.BindString(0, ad_info_category.first);
+    delete_statement.BindString(1, ad_info_category.second);
+    if (!delete_statement.Run())
       return false;
-    }
+    *deleted_rows = true;
   }
 
   return true;
 }
 
-bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
-    const ads::AdInfo& ad_info,
-    const std::string& category) {
+bool BundleStateDatabase::InsertOrUpdateCategory(const std::string& category) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  bool initialized = Init();
-  DCHECK(initialized);
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "INSERT OR IGNORE INTO category "
+          "(name) "
+          "VALUES (?)"));
 
-  if (!initialized)
-    return false;
+  ad_info_statement.BindString(0, category);
+
+  return ad_info_statement.Run();
+}
+
+bool BundleStateDatabase::InsertOrUpdateAdInfo(
+    const ads::AdInfo& info,
+    const std::string& region) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Rows which didn't change are left alone, so they aren't rewritten.
+  sql::Statement ad_info_statement(
+      GetDB().GetCachedStatement(SQL_FROM_HERE,
+          "INSERT INTO ad_info "
+          "(creative_set_id, advertiser, notification_text, "
+          "notification_url, start_timestamp, end_timestamp, uuid, "
+          "campaign_id, daily_cap, per_day, total_max, region) "
+          "VALUES (?, ?, ?, ?, datetime(?), datetime(?), ?, ?, ?, ?, ?, ?) "
+          "ON CONFLICT (region, uuid) DO UPDATE SET "
+          "creative_set_id = excluded.creative_set_id, "
+          "advertiser = excluded.advertiser, "
+          "notification_text = excluded.notification_text, "
+          "notification_url = excluded.notification_url, "
+          "start_timestamp = excluded.start_timestamp, "
+          "end_timestamp = excluded.end_timestamp, "
+          "campaign_id = excluded.campaign_id, "
+          "daily_cap = excluded.daily_cap, "
+          "per_day = excluded.per_day, "
+          "total_max = excluded.total_max "
+          "WHERE creative_set_id IS NOT excluded.creative_set_id OR "
+          "advertiser IS NOT excluded.advertiser OR "
+          "notification_text IS NOT excluded.notification_text OR "
+          "notification_url IS NOT excluded.notification_url OR "
+          "start_timestamp IS NOT excluded.start_timestamp OR "
+          "end_timestamp IS NOT excluded.end_timestamp OR "
+          "campaign_id IS NOT excluded.campaign_id OR "
+          "daily_cap IS NOT excluded.daily_cap OR "
+          "per_day IS NOT excluded.per_day OR "
+          "total_max IS NOT excluded.total_max"));
+
+  ad_info_statement.BindString(0, info.creative_set_id);
+  ad_info_statement.BindString(1, info.advertiser);
+  ad_info_statement.BindString(2, info.notification_text);
+  ad_info_statement.BindString(3, info.notification_url);
+  ad_info_statement.BindString(4, info.start_timestamp);
+  ad_info_statement.BindString(5, info.end_timestamp);
+  ad_info_statement.BindString(6, info.uuid);
+  ad_info_statement.BindString(7, info.campaign_id);
+  ad_info_statement.BindInt(8, info.daily_cap);
+  ad_info_statement.BindInt(9, info.per_day);
+  ad_info_statement.BindInt(10, info.total_max);
+  ad_info_statement.BindString(11, region);
+
+  return ad_info_statement.Run();
+}
+
+bool BundleStateDatabase::InsertOrUpdateAdInfoCategory(
+    const std::string& ad_info_uuid,
+    const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   sql::Statement ad_info_statement(
       GetDB().GetCachedStatement(SQL_FROM_HERE,
-          "INSERT OR REPLACE INTO ad_info_category "
+          "INSERT OR IGNORE INTO ad_info_category "
           "(ad_info_uuid, category_name) "
           "VALUES (?, ?)"));
 
-  ad_info_statement.BindString(0, ad_info.uuid);
+  ad_info_statement.BindString(0, ad_info_uuid);
   ad_info_statement.BindString(1, category);
 
   return ad_info_statement.Run();
@@ -347,6 +431,27 @@ bool BundleStateDatabase::GetAdsForCategory(
   if (!initialized)
     return false;
 
+  auto ads_for_category = ads_for_category_.find(category);
+  if (ads_for_category == ads_for_category_.end()) {
+    ads_for_category = ads_for_category_.emplace(
+        category, LoadAdsForCategory(category)).first;
+  }
+
+  // Same as filtering on "start_timestamp <= now AND end_timestamp >= now" in
+  // SQL, since SQLite compares these as strings too.
+  const std::string now = GetLocalTimeString(base::Time::Now());
+  for (const auto& info : ads_for_category->second) {
+    if (info.start_timestamp <= now && info.end_timestamp >= now)
+      ads->push_back(info);
+  }
+
+  return true;
+}
+
+std::vector<ads::AdInfo> BundleStateDatabase::LoadAdsForCategory(
+    const std::string& category) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
   sql::Statement info_sql(
       db_.GetUniqueStatement(
           "SELECT ai.creative_set_id, ai.advertiser, "
@@ -357,12 +462,11 @@ bool BundleStateDatabase::GetAdsForCategory(
           "INNER JOIN ad_info_category AS aic "
           "ON aic.ad_info_uuid = ai.uuid "
           "WHERE aic.category_name = ? and "
-          "ai.start_timestamp <= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime')) and "
-          "ai.end_timestamp >= strftime('%Y-%m-%d %H:%M', "
-          "datetime('now','localtime'));"));
+          "ai.start_timestamp IS NOT NULL and "
+          "ai.end_timestamp IS NOT NULL;"));
   info_sql.BindString(0, category);
 
+  std::vector<ads::AdInfo> ads;
   while (info_sql.Step()) {
     ads::AdInfo info;
     info.creative_set_id = info_sql.ColumnString(0);
@@ -376,10 +480,10 @@ bool BundleStateDatabase::GetAdsForCategory(
     info.daily_cap = info_sql.ColumnInt(9);
     info.per_day = info_sql.ColumnInt(10);
     info.total_max = info_sql.ColumnInt(11);
-    ads->emplace_back(info);
+    ads.emplace_back(info);
   }
 
-  return true;
+  return ads;
 }
 
 // static
@@ -401,6 +505,7 @@ void BundleStateDatabase::Vacuum() {
 void BundleStateDatabase::OnMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  ads_for_category_.clear();
   db_.TrimMemory();
 }
 
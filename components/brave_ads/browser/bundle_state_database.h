@@ -7,7 +7,10 @@
 #define BRAVE_COMPONENTS_BRAVE_ADS_BROWSER_BUNDLE_STATE_DATABASE_H_
 
 #include <stddef.h>
+#include <map>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -51,6 +54,8 @@ class BundleStateDatabase {
   std::string GetDiagnosticInfo(int extended_error, sql::Statement* statement);
 
  private:
+  friend class BundleStateDatabaseTest;
+
   bool Init();
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
@@ -60,16 +65,30 @@ class BundleStateDatabase {
   bool CreateAdInfoCategoryTable();
   bool CreateAdInfoCategoryNameIndex();
 
-  bool TruncateCategoryTable();
-  bool TruncateAdInfoTable();
-  bool TruncateAdInfoCategoryTable();
+  // (region, uuid) of each ad_info row, to the ad stored in it.
+  using AdInfoRows =
+      std::map<std::pair<std::string, std::string>, const ads::AdInfo*>;
+  // (ad_info_uuid, category_name) of each ad_info_category row.
+  using AdInfoCategoryRows = std::set<std::pair<std::string, std::string>>;
+
+  // Delete the stored rows which aren't part of the new bundle, and set
+  // |deleted_rows| if there were any.
+  bool DeleteRemovedCategories(const std::set<std::string>& categories,
+                               bool* deleted_rows);
+  bool DeleteRemovedAdInfo(const AdInfoRows& ad_infos, bool* deleted_rows);
+  bool DeleteRemovedAdInfoCategories(
+      const AdInfoCategoryRows& ad_info_categories,
+      bool* deleted_rows);
 
   bool InsertOrUpdateCategory(const std::string& category);
-  bool InsertOrUpdateAdInfo(const ads::AdInfo& info);
+  bool InsertOrUpdateAdInfo(const ads::AdInfo& info, const std::string& region);
   bool InsertOrUpdateAdInfoCategory(
-      const ads::AdInfo& ad_info,
+      const std::string& ad_info_uuid,
       const std::string& category);
 
+  // Returns the ads of |category| whatever their start and end timestamps.
+  std::vector<ads::AdInfo> LoadAdsForCategory(const std::string& category);
+
   sql::Database& GetDB();
   sql::MetaTable& GetMetaTable();
 
@@ -81,6 +100,11 @@ class BundleStateDatabase {
   const base::FilePath db_path_;
   bool initialized_;
 
+  // Ads of each category served so far, before filtering them by date, so that
+  // serving an ad doesn't query the database. Cleared whenever the bundle
+  // state is saved.
+  std::map<std::string, std::vector<ads::AdInfo>> ads_for_category_;
+
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   SEQUENCE_CHECKER(sequence_checker_);
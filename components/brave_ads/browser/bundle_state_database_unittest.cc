@@ -0,0 +1,122 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_ads/browser/bundle_state_database.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/scoped_task_environment.h"
+#include "sql/statement.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// npm run test -- brave_unit_tests --filter=BundleStateDatabaseTest.*
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+namespace brave_ads {
+
+namespace {
+
+ads::AdInfo CreateAdInfo(const std::string& uuid) {
+  ads::AdInfo info;
+  info.creative_set_id = "creative-set-" + uuid;
+  info.campaign_id = "campaign-" + uuid;
+  info.start_timestamp = "2000-01-01 00:00";
+  info.end_timestamp = "2100-01-01 00:00";
+  info.daily_cap = 1;
+  info.per_day = 2;
+  info.total_max = 3;
+  info.regions = {"US"};
+  info.advertiser = "advertiser";
+  info.notification_text = "text " + uuid;
+  info.notification_url = "https://brave.com/" + uuid;
+  info.uuid = uuid;
+  return info;
+}
+
+}  // namespace
+
+class BundleStateDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    database_ = std::make_unique<BundleStateDatabase>(
+        temp_dir_.GetPath().AppendASCII("BundleStateDatabaseTest.db"));
+  }
+
+  // Returns the rows selected by |sql|, with their columns joined by '|'.
+  std::vector<std::string> GetRows(const char* sql) {
+    std::vector<std::string> rows;
+    sql::Statement statement(database_->GetDB().GetUniqueStatement(sql));
+    while (statement.Step()) {
+      std::string row;
+      for (int i = 0; i < statement.ColumnCount(); i++) {
+        if (i)
+          row += "|";
+        row += statement.ColumnString(i);
+      }
+      rows.push_back(row);
+    }
+    return rows;
+  }
+
+  // Returns the ads served for |category|, as uuid|notification_text.
+  std::vector<std::string> GetAdsForCategory(const std::string& category) {
+    std::vector<ads::AdInfo> ads;
+    EXPECT_TRUE(database_->GetAdsForCategory(category, &ads));
+    std::vector<std::string> rows;
+    for (const auto& ad : ads)
+      rows.push_back(ad.uuid + "|" + ad.notification_text);
+    return rows;
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<BundleStateDatabase> database_;
+};
+
+TEST_F(BundleStateDatabaseTest, SaveBundleStateWritesOnlyTheNewBundle) {
+  ads::BundleState bundle_state;
+  bundle_state.categories["technology"] = {
+      CreateAdInfo("ad-1"), CreateAdInfo("ad-2"), CreateAdInfo("ad-3")};
+  bundle_state.categories["sports"] = {CreateAdInfo("ad-4")};
+  ASSERT_TRUE(database_->SaveBundleState(bundle_state));
+
+  EXPECT_THAT(GetAdsForCategory("technology"),
+              UnorderedElementsAre("ad-1|text ad-1", "ad-2|text ad-2",
+                                   "ad-3|text ad-3"));
+  EXPECT_THAT(GetAdsForCategory("sports"), ElementsAre("ad-4|text ad-4"));
+
+  // One ad changed, one removed and the sports category dropped.
+  ads::BundleState updated_bundle_state;
+  ads::AdInfo changed_ad = CreateAdInfo("ad-1");
+  changed_ad.notification_text = "changed";
+  updated_bundle_state.categories["technology"] = {changed_ad,
+                                                   CreateAdInfo("ad-2")};
+  ASSERT_TRUE(database_->SaveBundleState(updated_bundle_state));
+
+  EXPECT_THAT(GetRows("SELECT name FROM category"), ElementsAre("technology"));
+  EXPECT_THAT(
+      GetRows("SELECT region, uuid, notification_text, start_timestamp "
+              "FROM ad_info ORDER BY uuid"),
+      ElementsAre("US|ad-1|changed|2000-01-01 00:00:00",
+                  "US|ad-2|text ad-2|2000-01-01 00:00:00"));
+  EXPECT_THAT(GetRows("SELECT ad_info_uuid, category_name "
+                      "FROM ad_info_category ORDER BY ad_info_uuid"),
+              ElementsAre("ad-1|technology", "ad-2|technology"));
+
+  // The ads cached by the first lookups are not served anymore.
+  EXPECT_THAT(GetAdsForCategory("technology"),
+              UnorderedElementsAre("ad-1|changed", "ad-2|text ad-2"));
+  EXPECT_TRUE(GetAdsForCategory("sports").empty());
+}
+
+}  // namespace brave_ads
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 
+#include <memory>
 #include <string>
 
 #include "base/logging.h"
@@ -13,8 +14,7 @@
 
 namespace brave_component_updater {
 
-void GetDATFileData(const base::FilePath& file_path,
-                    DATFileDataBuffer* buffer) {
+DATFileDataBuffer GetDATFileData(const base::FilePath& file_path) {
   int64_t size = 0;
   if (!base::PathExists(file_path) ||
       !base::GetFileSize(file_path, &size) ||
@@ -22,16 +22,16 @@ void GetDATFileData(const base::FilePath& file_path,
     LOG(ERROR) << "GetDATFileData: "
                << "the dat file is not found or corrupted "
                << file_path;
-    return;
+    return nullptr;
   }
 
-  buffer->resize(size);
-  if (size != base::ReadFile(file_path,
-                             reinterpret_cast<char*>(&buffer->front()),
-                             size)) {
+  auto buffer = std::make_unique<base::MemoryMappedFile>();
+  if (!buffer->Initialize(file_path)) {
     LOG(ERROR) << "GetDATFileData: cannot "
-               << "read dat file " << file_path;
+               << "map dat file " << file_path;
+    return nullptr;
   }
+  return buffer;
 }
 
 std::string GetDATFileAsString(const base::FilePath& file_path) {
@@ -6,19 +6,24 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 #define BRAVE_COMPONENTS_BRAVE_COMPONENT_UPDATER_BROWSER_DAT_FILE_UTIL_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
-using DATFileDataBuffer = std::vector<unsigned char>;
+// Read-only mapping of a DAT file. The clients deserialized from it may point
+// into it, so it must be kept alive as long as they are; the pages are shared
+// with the page cache instead of being copied to the heap.
+using DATFileDataBuffer = std::unique_ptr<base::MemoryMappedFile>;
 
-void GetDATFileData(const base::FilePath& file_path,
-                    DATFileDataBuffer* buffer);
+// Returns null if the file is missing, empty or can't be mapped.
+DATFileDataBuffer GetDATFileData(const base::FilePath& file_path);
 std::string GetDATFileAsString(const base::FilePath& file_path);
 
 template<typename T>
@@ -28,13 +33,14 @@ using LoadDATFileDataResult =
 template<typename T>
 LoadDATFileDataResult<T> LoadDATFileData(
     const base::FilePath& dat_file_path) {
-  DATFileDataBuffer buffer;
-  GetDATFileData(dat_file_path, &buffer);
+  DATFileDataBuffer buffer = GetDATFileData(dat_file_path);
   std::unique_ptr<T> client;
   client = std::make_unique<T>();
-  if (buffer.empty() ||
-      !client->deserialize(reinterpret_cast<char*>(&buffer.front()),
-          buffer.size()))
+  // The deserializers only read from the buffer, despite taking a char*.
+  if (!buffer ||
+      !client->deserialize(
+          reinterpret_cast<char*>(const_cast<uint8_t*>(buffer->data())),
+          buffer->length()))
     client.reset();
 
   return LoadDATFileDataResult<T>(
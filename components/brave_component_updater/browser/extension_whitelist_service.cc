@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/stl_util.h"
 #include "base/task_runner_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_service.h"
 #include "brave/vendor/extension-whitelist/extension_whitelist_parser.h"
@@ -22,13 +23,15 @@ ExtensionWhitelistService::ExtensionWhitelistService(
     const std::vector<std::string>& whitelist)
     : LocalDataFilesObserver(local_data_files_service),
       extension_whitelist_client_(new ExtensionWhitelistParser()),
-      whitelist_(whitelist),
+      file_task_runner_(local_data_files_service->GetTaskRunner()),
+      whitelist_(whitelist.begin(), whitelist.end()),
       weak_factory_(this) {
 }
 
 ExtensionWhitelistService::~ExtensionWhitelistService() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   extension_whitelist_client_.reset();
+  ReleaseBuffer(std::move(buffer_));
 }
 
 bool ExtensionWhitelistService::IsWhitelisted(
@@ -48,8 +51,7 @@ bool ExtensionWhitelistService::IsVetted(const Extension* extension) const {
 }
 
 bool ExtensionWhitelistService::IsVetted(const std::string& id) const {
-  if (std::find(whitelist_.begin(), whitelist_.end(), id) !=
-      whitelist_.end())
+  if (base::Contains(whitelist_, id))
     return true;
 
   return IsWhitelisted(id);
@@ -76,19 +78,28 @@ void ExtensionWhitelistService::OnComponentReady(
 
 void ExtensionWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (result.second.empty()) {
+  if (!result.second) {
     LOG(ERROR) << "Could not obtain extension whitelist data";
     return;
   }
   if (!result.first.get()) {
     LOG(ERROR) << "Failed to deserialize extension whitelist data";
+    ReleaseBuffer(std::move(result.second));
     return;
   }
 
+  // The old client may point into the old buffer, so it goes first.
   extension_whitelist_client_ = std::move(result.first);
+  ReleaseBuffer(std::move(buffer_));
   buffer_ = std::move(result.second);
 }
 
+void ExtensionWhitelistService::ReleaseBuffer(
+    brave_component_updater::DATFileDataBuffer buffer) {
+  if (buffer)
+    file_task_runner_->DeleteSoon(FROM_HERE, buffer.release());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<ExtensionWhitelistService> ExtensionWhitelistServiceFactory(
@@ -12,9 +12,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_set.h"
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/sequenced_task_runner.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 
@@ -54,11 +57,14 @@ class ExtensionWhitelistService : public LocalDataFilesObserver {
   friend class ::BravePDFDownloadTest;
 
   void OnGetDATFileData(GetDATFileDataResult result);
+  void ReleaseBuffer(brave_component_updater::DATFileDataBuffer buffer);
 
   SEQUENCE_CHECKER(sequence_checker_);
   std::unique_ptr<ExtensionWhitelistParser> extension_whitelist_client_;
   brave_component_updater::DATFileDataBuffer buffer_;
-  std::vector<std::string> whitelist_;
+  // Unmapping may block, so |buffer_| is released on this runner.
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  base::flat_set<std::string> whitelist_;
   base::WeakPtrFactory<ExtensionWhitelistService> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(ExtensionWhitelistService);
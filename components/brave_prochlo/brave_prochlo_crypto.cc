@@ -13,16 +13,29 @@ BraveProchloCrypto::BraveProchloCrypto() = default;
 
 bool BraveProchloCrypto::load_analyzer_key_from_bytes(
     const std::vector<char>& bytes) {
-  public_analyzer_key_ = load_public_key_from_bytes(bytes);
+  set_analyzer_key(load_public_key_from_bytes(bytes));
   return public_analyzer_key_ != nullptr;
 }
 
 bool BraveProchloCrypto::load_shuffler_key_from_bytes(
     const std::vector<char>& bytes) {
-  public_shuffler_key_ = load_public_key_from_bytes(bytes);
+  set_shuffler_key(load_public_key_from_bytes(bytes));
   return public_shuffler_key_ != nullptr;
 }
 
+bool BraveProchloCrypto::use_keys(EVP_PKEY* shuffler_key,
+                                  EVP_PKEY* analyzer_key) {
+  if (shuffler_key == nullptr || analyzer_key == nullptr) {
+    return false;
+  }
+  EVP_PKEY_up_ref(shuffler_key);
+  set_shuffler_key(shuffler_key);
+  EVP_PKEY_up_ref(analyzer_key);
+  set_analyzer_key(analyzer_key);
+  return true;
+}
+
+// static
 EVP_PKEY* BraveProchloCrypto::load_public_key_from_bytes(
     const std::vector<char>& bytes) {
   bssl::UniquePtr<BIO> bio(
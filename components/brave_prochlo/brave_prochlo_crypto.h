@@ -17,16 +17,20 @@ class BraveProchloCrypto : public Crypto {
  public:
   BraveProchloCrypto();
 
+  // Parse a PEM public key. The caller owns the result.
+  static EVP_PKEY* load_public_key_from_bytes(const std::vector<char>& bytes);
+
   // Load the public key for the Analyzer from bytes.
   bool load_analyzer_key_from_bytes(const std::vector<char>& bytes);
 
   // Load the public key for the Analyzer from bytes.
   bool load_shuffler_key_from_bytes(const std::vector<char>& bytes);
 
- private:
-  // Load a public key returning the structure.
-  EVP_PKEY* load_public_key_from_bytes(const std::vector<char>& bytes);
+  // Use already parsed public keys, so they are not parsed for every message.
+  // Takes a new reference to each of them.
+  bool use_keys(EVP_PKEY* shuffler_key, EVP_PKEY* analyzer_key);
 
+ private:
   DISALLOW_COPY_AND_ASSIGN(BraveProchloCrypto);
 };
 
@@ -35,10 +35,28 @@ MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEQCeVJbcADloHb8bwftIi1UO0smiz
 8ObdAFQ8j3U9cMehGqI3zXgS8APvBW/9XxMkb4XWQe+t9h6qHq82P6zcBg==
 -----END PUBLIC KEY-----)";
 
-bool MakeProchlomation(uint64_t metric,
+// The keys are parsed once and shared by every message. EVP_PKEY is
+// reference counted, and each BraveProchloCrypto takes its own reference.
+EVP_PKEY* GetShufflerKey() {
+  static EVP_PKEY* const key = BraveProchloCrypto::load_public_key_from_bytes(
+      std::vector<char>(&kShufflerKey[0],
+                        &kShufflerKey[0] + base::size(kShufflerKey)));
+  return key;
+}
+
+EVP_PKEY* GetAnalyzerKey() {
+  static EVP_PKEY* const key = BraveProchloCrypto::load_public_key_from_bytes(
+      std::vector<char>(&kAnalyzerKey[0],
+                        &kAnalyzerKey[0] + base::size(kAnalyzerKey)));
+  return key;
+}
+
+bool MakeProchlomation(BraveProchloCrypto* crypto,
+                       uint64_t metric,
                        const uint8_t* data,
                        const uint8_t* crowd_id,
                        ShufflerItem* shuffler_item) {
+  DCHECK(crypto);
   DCHECK(data);
   DCHECK(crowd_id);
   DCHECK(shuffler_item);
@@ -46,20 +64,6 @@ bool MakeProchlomation(uint64_t metric,
   // to src/base/trace_event/builtin_categories.h
   // TRACE_EVENT0("brave_p3a", "MakeProchlomation");
 
-  BraveProchloCrypto crypto;
-
-  const std::vector<char> shuffler_key(
-      &kShufflerKey[0], &kShufflerKey[0] + base::size(kShufflerKey));
-  if (!crypto.load_shuffler_key_from_bytes(shuffler_key)) {
-    return false;
-  }
-
-  const std::vector<char> analyzer_key(
-      &kAnalyzerKey[0], &kAnalyzerKey[0] + base::size(kAnalyzerKey));
-  if (!crypto.load_analyzer_key_from_bytes(analyzer_key)) {
-    return false;
-  }
-
   // We have to create a Prochlomation and a PlainShufflerItem to encrypt them
   // both into an AnalyzerItea and a ShufflerItem, respectively. We'll stage
   // those here. We can probably do this more efficiently to avoid copies.
@@ -71,8 +75,8 @@ bool MakeProchlomation(uint64_t metric,
   memcpy(prochlomation.data, data, kProchlomationDataLength);
 
   // Then the AnalyzerItem of the PlainShufflerItem
-  if (!crypto.EncryptForAnalyzer(prochlomation,
-                                 &plain_shuffler_item.analyzer_item)) {
+  if (!crypto->EncryptForAnalyzer(prochlomation,
+                                  &plain_shuffler_item.analyzer_item)) {
     NOTREACHED();
     return false;
   }
@@ -81,7 +85,7 @@ bool MakeProchlomation(uint64_t metric,
   memcpy(plain_shuffler_item.crowd_id, crowd_id, kCrowdIdLength);
 
   // And create the ShufflerItem
-  if (!crypto.EncryptForShuffler(plain_shuffler_item, shuffler_item)) {
+  if (!crypto->EncryptForShuffler(plain_shuffler_item, shuffler_item)) {
     NOTREACHED();
     return false;
   }
@@ -101,22 +105,25 @@ void InitProchloMessage(uint64_t metric_hash,
   value->set_client_public_key(item.client_public_key, kPublicKeyLength);
 }
 
-}  // namespace
-
-MessageMetainfo::MessageMetainfo() = default;
-MessageMetainfo::~MessageMetainfo() = default;
+// Describes the sender, it is the same for all values of a message.
+std::string MakeMetastring(const MessageMetainfo& meta) {
+  // Find out years of install and survey.
+  base::Time::Exploded exploded;
+  meta.date_of_survey.LocalExplode(&exploded);
+  DCHECK_GE(exploded.year, 999);
+  const std::string yos = base::NumberToString(exploded.year).substr(2, 4);
+  meta.date_of_install.LocalExplode(&exploded);
+  DCHECK_GE(exploded.year, 999);
+  const std::string yoi = base::NumberToString(exploded.year).substr(2, 4);
 
-void GenerateProchloMessage(uint64_t metric_hash,
-                            uint64_t metric_value,
-                            const MessageMetainfo& meta,
-                            brave_pyxis::PyxisMessage* pyxis_message) {
-  // TODO(iefremov): - create patch for adding `brave_p3a`
-  // to src/base/trace_event/builtin_categories.h
-  // TRACE_EVENT0("brave_p3a", "GenerateProchloMessage");
-  ShufflerItem item;
-  uint8_t data[kProchlomationDataLength] = {0};
-  uint8_t crowd_id[kCrowdIdLength] = {0};
+  return "," + meta.country_code + "," + meta.platform + "," + meta.version +
+         "," + meta.channel + "," + yoi + base::NumberToString(meta.woi) + "," +
+         yos + base::NumberToString(meta.wos) + "," + meta.refcode + ",";
+}
 
+void FillProchlomationData(uint64_t metric_value,
+                           const std::string& metastring,
+                           uint8_t* data) {
   // First byte contains the 4 booleans.
   const char daily = 1;
   const char weekly = 0;
@@ -126,20 +133,6 @@ void GenerateProchloMessage(uint64_t metric_hash,
   uint8_t* ptr = data;
   ptr++;
 
-  // Find out years of install and survey.
-  base::Time::Exploded exploded;
-  meta.date_of_survey.LocalExplode(&exploded);
-  DCHECK_GE(exploded.year, 999);
-  const std::string yos = base::NumberToString(exploded.year).substr(2, 4);
-  meta.date_of_install.LocalExplode(&exploded);
-  DCHECK_GE(exploded.year, 999);
-  const std::string yoi = base::NumberToString(exploded.year).substr(2, 4);
-
-  const std::string metastring =
-      "," + meta.country_code + "," + meta.platform + "," + meta.version + "," +
-      meta.channel + "," + yoi + base::NumberToString(meta.woi) + "," + yos +
-      base::NumberToString(meta.wos) + "," + meta.refcode + ",";
-
   const std::string metric_value_str = base::NumberToString(metric_value);
 
   // TODO(iefremov): replace with 'if'?
@@ -149,14 +142,52 @@ void GenerateProchloMessage(uint64_t metric_hash,
   memcpy(ptr, metastring.data(), metastring.size());
   ptr += metastring.size();
   memcpy(ptr, metric_value_str.data(), metric_value_str.size());
+}
 
-  // TODO(iefremov): Salt?
-  crypto::SHA256HashString(
-      base::NumberToString(metric_hash) + base::NumberToString(metric_value),
-      crowd_id, kCrowdIdLength);
-  MakeProchlomation(metric_hash, data, crowd_id, &item);
+}  // namespace
 
-  InitProchloMessage(metric_hash, item, pyxis_message);
+MessageMetainfo::MessageMetainfo() = default;
+MessageMetainfo::~MessageMetainfo() = default;
+
+void GenerateProchloMessage(uint64_t metric_hash,
+                            uint64_t metric_value,
+                            const MessageMetainfo& meta,
+                            brave_pyxis::PyxisMessage* pyxis_message) {
+  GenerateProchloMessages({{metric_hash, metric_value}}, meta, pyxis_message);
+}
+
+void GenerateProchloMessages(
+    const std::vector<std::pair<uint64_t, uint64_t>>& metrics,
+    const MessageMetainfo& meta,
+    brave_pyxis::PyxisMessage* pyxis_message) {
+  // TODO(iefremov): - create patch for adding `brave_p3a`
+  // to src/base/trace_event/builtin_categories.h
+  // TRACE_EVENT0("brave_p3a", "GenerateProchloMessage");
+  BraveProchloCrypto prochlo_crypto;
+  if (!prochlo_crypto.use_keys(GetShufflerKey(), GetAnalyzerKey())) {
+    return;
+  }
+  const std::string metastring = MakeMetastring(meta);
+
+  for (const auto& metric : metrics) {
+    const uint64_t metric_hash = metric.first;
+    const uint64_t metric_value = metric.second;
+    ShufflerItem item;
+    uint8_t data[kProchlomationDataLength] = {0};
+    uint8_t crowd_id[kCrowdIdLength] = {0};
+    FillProchlomationData(metric_value, metastring, data);
+
+    // TODO(iefremov): Salt?
+    crypto::SHA256HashString(
+        base::NumberToString(metric_hash) + base::NumberToString(metric_value),
+        crowd_id, kCrowdIdLength);
+    if (!MakeProchlomation(&prochlo_crypto, metric_hash, data, crowd_id,
+                           &item)) {
+      continue;
+    }
+
+    InitProchloMessage(metric_hash, item, pyxis_message);
+  }
 }
 
 void GenerateP3AMessage(uint64_t metric_hash,
@@ -167,39 +198,7 @@ void GenerateP3AMessage(uint64_t metric_hash,
   // to src/base/trace_event/builtin_categories.h
   // TRACE_EVENT0("brave_p3a", "GenerateP3AMessage");
   uint8_t data[kProchlomationDataLength] = {0};
-
-  // First byte contains the 4 booleans.
-  const char daily = 1;
-  const char weekly = 0;
-  const char monthly = 2;
-  const char first = 0;
-  data[0] = daily | weekly | monthly | first;
-  uint8_t* ptr = data;
-  ptr++;
-
-  // Find out years of install and survey.
-  base::Time::Exploded exploded;
-  meta.date_of_survey.LocalExplode(&exploded);
-  DCHECK_GE(exploded.year, 999);
-  const std::string yos = base::NumberToString(exploded.year).substr(2, 4);
-  meta.date_of_install.LocalExplode(&exploded);
-  DCHECK_GE(exploded.year, 999);
-  const std::string yoi = base::NumberToString(exploded.year).substr(2, 4);
-
-  const std::string metastring =
-      "," + meta.country_code + "," + meta.platform + "," + meta.version + "," +
-      meta.channel + "," + yoi + base::NumberToString(meta.woi) + "," + yos +
-      base::NumberToString(meta.wos) + "," + meta.refcode + ",";
-
-  const std::string metric_value_str = base::NumberToString(metric_value);
-
-  // TODO(iefremov): replace with 'if'?
-  CHECK_LE(metastring.size() + metric_value_str.size(),
-           kProchlomationDataLength - 1);
-
-  memcpy(ptr, metastring.data(), metastring.size());
-  ptr += metastring.size();
-  memcpy(ptr, metric_value_str.data(), metric_value_str.size());
+  FillProchlomationData(metric_value, MakeMetastring(meta), data);
 
   // Init the message.
   p3a_message->set_metric_id(metric_hash);
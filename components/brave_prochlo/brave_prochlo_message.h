@@ -8,6 +8,9 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
+
 #include "base/time/time.h"
 
 namespace brave_pyxis {
@@ -38,6 +41,14 @@ void GenerateProchloMessage(uint64_t metric_hash,
                             const MessageMetainfo& meta,
                             brave_pyxis::PyxisMessage* prochlo_message);
 
+// Same as above for many metrics at once: adds a value per
+// (metric hash, metric value) pair to |prochlo_message|. The encryption
+// contexts are set up once for the whole batch.
+void GenerateProchloMessages(
+    const std::vector<std::pair<uint64_t, uint64_t>>& metrics,
+    const MessageMetainfo& meta,
+    brave_pyxis::PyxisMessage* prochlo_message);
+
 void GenerateP3AMessage(uint64_t metric_hash,
                         uint64_t metric_value,
                         const MessageMetainfo& meta,
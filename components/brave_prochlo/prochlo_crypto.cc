@@ -32,15 +32,37 @@
 namespace prochlo {
 
 bool Crypto::load_analyzer_key(const std::string& keyfile) {
-  public_analyzer_key_ = load_public_key(keyfile);
+  set_analyzer_key(load_public_key(keyfile));
   return public_analyzer_key_ != nullptr;
 }
 
 bool Crypto::load_shuffler_key(const std::string& keyfile) {
-  public_shuffler_key_ = load_public_key(keyfile);
+  set_shuffler_key(load_public_key(keyfile));
   return public_shuffler_key_ != nullptr;
 }
 
+void Crypto::set_analyzer_key(EVP_PKEY* key) {
+  if (analyzer_keygen_ctx_ != nullptr) {
+    EVP_PKEY_CTX_free(analyzer_keygen_ctx_);
+    analyzer_keygen_ctx_ = nullptr;
+  }
+  if (public_analyzer_key_ != nullptr) {
+    EVP_PKEY_free(public_analyzer_key_);
+  }
+  public_analyzer_key_ = key;
+}
+
+void Crypto::set_shuffler_key(EVP_PKEY* key) {
+  if (shuffler_keygen_ctx_ != nullptr) {
+    EVP_PKEY_CTX_free(shuffler_keygen_ctx_);
+    shuffler_keygen_ctx_ = nullptr;
+  }
+  if (public_shuffler_key_ != nullptr) {
+    EVP_PKEY_free(public_shuffler_key_);
+  }
+  public_shuffler_key_ = key;
+}
+
 EVP_PKEY* Crypto::load_public_key(const std::string& keyfile) {
   FILE* fp = fopen(keyfile.c_str(), "r");
   if (fp == nullptr) {
@@ -59,7 +81,11 @@ EVP_PKEY* Crypto::load_public_key(const std::string& keyfile) {
 }
 
 Crypto::Crypto()
-    : public_shuffler_key_(nullptr), public_analyzer_key_(nullptr) {
+    : public_shuffler_key_(nullptr),
+      public_analyzer_key_(nullptr),
+      shuffler_keygen_ctx_(nullptr),
+      analyzer_keygen_ctx_(nullptr),
+      cipher_ctx_(nullptr) {
   // Pedantically check that we have the same endianness everywhere
   //  uint32_t number = 1;
   //  assert(reinterpret_cast<uint8_t*>(&number)[0] == 1);
@@ -69,11 +95,10 @@ Crypto::Crypto()
 }
 
 Crypto::~Crypto() {
-  if (public_shuffler_key_ != nullptr) {
-    EVP_PKEY_free(public_shuffler_key_);
-  }
-  if (public_analyzer_key_ != nullptr) {
-    EVP_PKEY_free(public_analyzer_key_);
+  set_shuffler_key(nullptr);
+  set_analyzer_key(nullptr);
+  if (cipher_ctx_ != nullptr) {
+    EVP_CIPHER_CTX_free(cipher_ctx_);
   }
 }
 
@@ -287,22 +312,12 @@ bool Crypto::GenerateKeyPair(EVP_PKEY* peer_public_key,
   assert(binary_key != nullptr);
   assert(*key_out == nullptr);
 
-  EVP_PKEY_CTX* ctx = nullptr;
   EVP_PKEY* key = nullptr;
-  BIO* bio = NULL;
 
   do {
     // Generate a key based on the peer's key parameters.
-    ctx = EVP_PKEY_CTX_new(peer_public_key, /*e=*/nullptr);
+    EVP_PKEY_CTX* ctx = GetKeygenContext(peer_public_key);
     if (ctx == nullptr) {
-      // warn("Couldn't create an EVP_PKEY_CTX.");
-      ERR_print_errors_fp(stderr);
-      break;
-    }
-
-    if (EVP_PKEY_keygen_init(ctx) != 1) {
-      // warn("Couldn't initialize the key-pair generation.");
-      ERR_print_errors_fp(stderr);
       break;
     }
 
@@ -312,33 +327,25 @@ bool Crypto::GenerateKeyPair(EVP_PKEY* peer_public_key,
       break;
     }
 
-    // Serialize the key.
-    bio = BIO_new(BIO_s_mem());
-    if (bio == nullptr) {
-      // warn("Couldn't allocate an OpenSSL buffer.");
+    // Serialize the key straight into |binary_key|. We'd better have
+    // provisioned enough space for the serialized public key.
+    int serialized_key_length = i2d_PUBKEY(key, nullptr);
+    if (serialized_key_length <= 0 ||
+        static_cast<size_t>(serialized_key_length) > kPublicKeyLength) {
+      // warn("Couldn't serialize a key pair.");
       ERR_print_errors_fp(stderr);
       break;
     }
 
-    if (i2d_PUBKEY_bio(bio, key) != 1) {
+    uint8_t* serialized_buffer = binary_key;
+    if (i2d_PUBKEY(key, &serialized_buffer) != serialized_key_length) {
       // warn("Couldn't serialize a key pair.");
       ERR_print_errors_fp(stderr);
       break;
     }
 
-    uint8_t* serialized_buffer = nullptr;
-    size_t serialized_key_length =
-        BIO_get_mem_data(bio, reinterpret_cast<char**>(&serialized_buffer));
-    // We'd better have provisioned enough space for the serialized public key.
-    assert(serialized_key_length <= kPublicKeyLength);
-
-    // Now write the results out (they OpenSSL key and the serialized key)
-    memcpy(binary_key, serialized_buffer, serialized_key_length);
-    *key_out = key;
-
     // Successful return.
-    EVP_PKEY_CTX_free(ctx);
-    BIO_free(bio);
+    *key_out = key;
     return true;
   } while (false);
 
@@ -347,13 +354,35 @@ bool Crypto::GenerateKeyPair(EVP_PKEY* peer_public_key,
   if (key != nullptr) {
     EVP_PKEY_free(key);
   }
-  if (ctx != nullptr) {
-    EVP_PKEY_CTX_free(ctx);
+  return false;
+}
+
+EVP_PKEY_CTX* Crypto::GetKeygenContext(EVP_PKEY* peer_public_key) {
+  assert(peer_public_key == public_analyzer_key_ ||
+         peer_public_key == public_shuffler_key_);
+  EVP_PKEY_CTX** ctx = peer_public_key == public_analyzer_key_
+                           ? &analyzer_keygen_ctx_
+                           : &shuffler_keygen_ctx_;
+  if (*ctx != nullptr) {
+    return *ctx;
+  }
+
+  EVP_PKEY_CTX* new_ctx = EVP_PKEY_CTX_new(peer_public_key, /*e=*/nullptr);
+  if (new_ctx == nullptr) {
+    // warn("Couldn't create an EVP_PKEY_CTX.");
+    ERR_print_errors_fp(stderr);
+    return nullptr;
   }
-  if (bio != nullptr) {
-    BIO_free(bio);
+
+  if (EVP_PKEY_keygen_init(new_ctx) != 1) {
+    // warn("Couldn't initialize the key-pair generation.");
+    ERR_print_errors_fp(stderr);
+    EVP_PKEY_CTX_free(new_ctx);
+    return nullptr;
   }
-  return false;
+
+  *ctx = new_ctx;
+  return new_ctx;
 }
 
 bool Crypto::DeriveSecretSymmetricKey(EVP_PKEY* local_key,
@@ -452,65 +481,58 @@ bool Crypto::DeriveSecretSymmetricKey(EVP_PKEY* local_key,
 bool Crypto::Encrypt(const uint8_t* symmetric_key, Encryption* encryption) {
   assert(encryption != nullptr);
 
-  EVP_CIPHER_CTX* ctx = nullptr;
-  do {
-    ctx = EVP_CIPHER_CTX_new();
-    if (ctx == nullptr) {
+  if (cipher_ctx_ == nullptr) {
+    cipher_ctx_ = EVP_CIPHER_CTX_new();
+    if (cipher_ctx_ == nullptr) {
       // warn("Couldn't create a new EVP_CIPHER_CTX.");
       ERR_print_errors_fp(stderr);
-      break;
-    }
-
-    EVP_CIPHER_CTX_init(ctx);
-
-    // Set up a random nonce
-    if (RAND_bytes(encryption->ToNonce(), kNonceLength) != 1) {
-      // warn("Couldn't generate random nonce.");
-      ERR_print_errors_fp(stderr);
-      break;
-    }
-
-    if (EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(),
-                           /* impl= */ nullptr, symmetric_key,
-                           /* iv= */ encryption->ToNonce()) != 1) {
-      // warn("Couldn't initialize for AES128-GCM encryption.");
-      ERR_print_errors_fp(stderr);
-      break;
+      return false;
     }
+  }
+  EVP_CIPHER_CTX* ctx = cipher_ctx_;
 
-    if (!encryption->StreamDataForEncryption(ctx)) {
-      // warn("Couldn't stream data for %s AES128-GCM encryption.",
-      // encryption->TypeString());
-      break;
-    }
+  // Set up a random nonce
+  if (RAND_bytes(encryption->ToNonce(), kNonceLength) != 1) {
+    // warn("Couldn't generate random nonce.");
+    ERR_print_errors_fp(stderr);
+    return false;
+  }
 
-    // Now finalize to obtain the tag. We should have no pending ciphertext data
-    // at this point.
-    int32_t out_length;
-    if (EVP_EncryptFinal_ex(ctx, /* out= */ nullptr, &out_length) != 1) {
-      // warn("Couldn't finalize the prochlomation encryption.");
-      ERR_print_errors_fp(stderr);
-      break;
-    }
-    assert(out_length == 0);
+  // Initializing again resets any state left by the previous message.
+  if (EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(),
+                         /* impl= */ nullptr, symmetric_key,
+                         /* iv= */ encryption->ToNonce()) != 1) {
+    // warn("Couldn't initialize for AES128-GCM encryption.");
+    ERR_print_errors_fp(stderr);
+    return false;
+  }
 
-    // We have filled in the ciphertext. Now we also need to fill in the tag.
-    if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagLength,
-                            encryption->ToTag()) != 1) {
-      // warn("Couldn't obtain the AEAD tag from the prochlomation
-      // encryption.");
-      ERR_print_errors_fp(stderr);
-      break;
-    }
+  if (!encryption->StreamDataForEncryption(ctx)) {
+    // warn("Couldn't stream data for %s AES128-GCM encryption.",
+    // encryption->TypeString());
+    return false;
+  }
 
-    EVP_CIPHER_CTX_free(ctx);
-    return true;
-  } while (false);
+  // Now finalize to obtain the tag. We should have no pending ciphertext data
+  // at this point.
+  int32_t out_length;
+  if (EVP_EncryptFinal_ex(ctx, /* out= */ nullptr, &out_length) != 1) {
+    // warn("Couldn't finalize the prochlomation encryption.");
+    ERR_print_errors_fp(stderr);
+    return false;
+  }
+  assert(out_length == 0);
 
-  if (ctx != nullptr) {
-    EVP_CIPHER_CTX_free(ctx);
+  // We have filled in the ciphertext. Now we also need to fill in the tag.
+  if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, kTagLength,
+                          encryption->ToTag()) != 1) {
+    // warn("Couldn't obtain the AEAD tag from the prochlomation
+    // encryption.");
+    ERR_print_errors_fp(stderr);
+    return false;
   }
-  return false;
+
+  return true;
 }
 
 }  // namespace prochlo
@@ -92,10 +92,17 @@ class Crypto {
     bool StreamDataForEncryption(EVP_CIPHER_CTX* ctx) override;
   };
 
+  // Replace a public key, taking ownership of |key|.
+  void set_analyzer_key(EVP_PKEY* key);
+  void set_shuffler_key(EVP_PKEY* key);
+
   bool MakeEncryptedMessage(Encryption* encryption);
   bool GenerateKeyPair(EVP_PKEY* peer_public_key,
                        EVP_PKEY** key_out,
                        uint8_t* binary_key);
+  // Returns the key generation context for |peer_public_key|, creating it on
+  // first use.
+  EVP_PKEY_CTX* GetKeygenContext(EVP_PKEY* peer_public_key);
 
   bool DeriveSecretSymmetricKey(EVP_PKEY* local_key,
                                 EVP_PKEY* peer_public_key,
@@ -107,6 +114,12 @@ class Crypto {
 
   EVP_PKEY* public_shuffler_key_;
   EVP_PKEY* public_analyzer_key_;
+
+  // Contexts are kept for all messages encrypted by this object. Every message
+  // still gets its own ephemeral key pair and nonce.
+  EVP_PKEY_CTX* shuffler_keygen_ctx_;
+  EVP_PKEY_CTX* analyzer_keygen_ctx_;
+  EVP_CIPHER_CTX* cipher_ctx_;
 };
 
 }  // namespace prochlo
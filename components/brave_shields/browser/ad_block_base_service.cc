@@ -115,6 +115,9 @@ AdBlockBaseService::~AdBlockBaseService() {
 
 void AdBlockBaseService::Cleanup() {
   GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
+  // After the client, which may point into it.
+  if (buffer_)
+    GetTaskRunner()->DeleteSoon(FROM_HERE, buffer_.release());
 }
 
 bool AdBlockBaseService::ShouldStartRequest(const GURL& url,
@@ -193,7 +196,7 @@ void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
 }
 
 void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
+  if (!result.second) {
     LOG(ERROR) << "Could not obtain ad block data";
     return;
   }
@@ -23,11 +23,13 @@ AutoplayWhitelistService::AutoplayWhitelistService(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service),
       autoplay_whitelist_client_(new AutoplayWhitelistParser()),
+      file_task_runner_(local_data_files_service->GetTaskRunner()),
       weak_factory_(this) {}
 
 AutoplayWhitelistService::~AutoplayWhitelistService() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   autoplay_whitelist_client_.reset();
+  ReleaseBuffer(std::move(buffer_));
 }
 
 bool AutoplayWhitelistService::ShouldAllowAutoplay(const GURL& url) {
@@ -58,19 +60,28 @@ void AutoplayWhitelistService::OnComponentReady(
 
 void AutoplayWhitelistService::OnGetDATFileData(GetDATFileDataResult result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (result.second.empty()) {
+  if (!result.second) {
     LOG(ERROR) << "Could not obtain autoplay whitelist data";
     return;
   }
   if (!result.first.get()) {
     LOG(ERROR) << "Failed to deserialize autoplay whitelist data";
+    ReleaseBuffer(std::move(result.second));
     return;
   }
 
+  // The old client may point into the old buffer, so it goes first.
   autoplay_whitelist_client_ = std::move(result.first);
+  ReleaseBuffer(std::move(buffer_));
   buffer_ = std::move(result.second);
 }
 
+void AutoplayWhitelistService::ReleaseBuffer(
+    brave_component_updater::DATFileDataBuffer buffer) {
+  if (buffer)
+    file_task_runner_->DeleteSoon(FROM_HERE, buffer.release());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // The autoplay whitelist factory
 std::unique_ptr<AutoplayWhitelistService> AutoplayWhitelistServiceFactory(
@@ -11,8 +11,10 @@
 #include <utility>
 
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/sequenced_task_runner.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
 #include "url/gurl.h"
@@ -46,9 +48,12 @@ class AutoplayWhitelistService : public LocalDataFilesObserver {
   friend class ::BraveContentSettingsObserverAutoplayTest;
 
   void OnGetDATFileData(GetDATFileDataResult result);
+  void ReleaseBuffer(brave_component_updater::DATFileDataBuffer buffer);
 
   std::unique_ptr<AutoplayWhitelistParser> autoplay_whitelist_client_;
   brave_component_updater::DATFileDataBuffer buffer_;
+  // Unmapping may block, so |buffer_| is released on this runner.
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
   SEQUENCE_CHECKER(sequence_checker_);
 
   base::WeakPtrFactory<AutoplayWhitelistService> weak_factory_;
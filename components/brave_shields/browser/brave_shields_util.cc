@@ -60,6 +60,33 @@ ContentSetting GetDefaultBlockFromControlType(ControlType type) {
 
 }  // namespace
 
+ShieldsSettings::ShieldsSettings(const GURL& tab_origin,
+                                 bool brave_shields_enabled,
+                                 bool allow_ads,
+                                 bool allow_http_upgradable_resource,
+                                 bool allow_referrers)
+    : tab_origin(tab_origin),
+      brave_shields_enabled(brave_shields_enabled),
+      allow_ads(allow_ads),
+      allow_http_upgradable_resource(allow_http_upgradable_resource),
+      allow_referrers(allow_referrers) {}
+
+ShieldsSettings::~ShieldsSettings() = default;
+
+scoped_refptr<const ShieldsSettings> GetShieldsSettings(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin) {
+  DCHECK(map);
+  return base::MakeRefCounted<ShieldsSettings>(
+      tab_origin,
+      GetBraveShieldsEnabled(map, tab_origin),
+      map->GetContentSetting(tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
+                             kAds) == CONTENT_SETTING_ALLOW,
+      map->GetContentSetting(tab_origin, GURL(), CONTENT_SETTINGS_TYPE_PLUGINS,
+                             kHTTPUpgradableResources) == CONTENT_SETTING_ALLOW,
+      AllowReferrers(map, tab_origin));
+}
+
 ContentSettingsPattern GetPatternFromURL(const GURL& url,
                                          bool scheme_wildcard) {
   DCHECK(url.is_empty() ? url.possibly_invalid_spec() == "" : url.is_valid());
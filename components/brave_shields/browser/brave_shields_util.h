@@ -9,15 +9,17 @@
 #include <stdint.h>
 #include <string>
 
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 #include "services/network/public/mojom/referrer_policy.mojom.h"
+#include "url/gurl.h"
 
 namespace content {
 struct Referrer;
 }
 
-class GURL;
 class HostContentSettingsMap;
 class Profile;
 
@@ -25,6 +27,34 @@ namespace brave_shields {
 
 enum ControlType { ALLOW = 0, BLOCK, BLOCK_THIRD_PARTY, DEFAULT, INVALID };
 
+// Immutable snapshot of the per-site shields settings that the network
+// delegate helpers consult for every request. It is resolved once per
+// top-level navigation and shared by all subresource requests of the frame
+// tree, so it can be handed across threads.
+struct ShieldsSettings : public base::RefCountedThreadSafe<ShieldsSettings> {
+  ShieldsSettings(const GURL& tab_origin,
+                  bool brave_shields_enabled,
+                  bool allow_ads,
+                  bool allow_http_upgradable_resource,
+                  bool allow_referrers);
+
+  const GURL tab_origin;
+  const bool brave_shields_enabled;
+  const bool allow_ads;
+  const bool allow_http_upgradable_resource;
+  const bool allow_referrers;
+
+ private:
+  friend class base::RefCountedThreadSafe<ShieldsSettings>;
+  ~ShieldsSettings();
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettings);
+};
+
+scoped_refptr<const ShieldsSettings> GetShieldsSettings(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin);
+
 ContentSettingsPattern GetPatternFromURL(const GURL& url,
                                          bool scheme_wildcard = false);
 std::string ControlTypeToString(ControlType type);
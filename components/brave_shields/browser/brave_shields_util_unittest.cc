@@ -1090,3 +1090,43 @@ TEST_F(BraveShieldsUtilTest, GetNoScriptControlType_ForOrigin) {
   setting = brave_shields::GetNoScriptControlType(profile(), GURL());
   EXPECT_EQ(ControlType::BLOCK, setting);
 }
+
+/* SHIELDS SETTINGS SNAPSHOT */
+TEST_F(BraveShieldsUtilTest, GetShieldsSettings_MatchesIndividualGetters) {
+  auto* map = HostContentSettingsMapFactory::GetForProfile(profile());
+  const GURL url("http://brave.com");
+
+  auto settings = brave_shields::GetShieldsSettings(map, url);
+  EXPECT_EQ(url, settings->tab_origin);
+  EXPECT_TRUE(settings->brave_shields_enabled);
+  EXPECT_FALSE(settings->allow_ads);
+  EXPECT_FALSE(settings->allow_http_upgradable_resource);
+  EXPECT_FALSE(settings->allow_referrers);
+
+  brave_shields::SetBraveShieldsEnabled(profile(), false, url);
+  brave_shields::SetAdControlType(profile(), ControlType::ALLOW, url);
+  brave_shields::SetHTTPSEverywhereEnabled(profile(), false, url);
+  map->SetContentSettingCustomScope(
+      ContentSettingsPattern::FromString("http://brave.com/*"),
+      ContentSettingsPattern::Wildcard(), CONTENT_SETTINGS_TYPE_PLUGINS,
+      brave_shields::kReferrers, CONTENT_SETTING_ALLOW);
+
+  // The previous snapshot is immutable.
+  EXPECT_TRUE(settings->brave_shields_enabled);
+  EXPECT_FALSE(settings->allow_ads);
+
+  settings = brave_shields::GetShieldsSettings(map, url);
+  EXPECT_EQ(brave_shields::GetBraveShieldsEnabled(profile(), url),
+            settings->brave_shields_enabled);
+  EXPECT_FALSE(settings->brave_shields_enabled);
+  EXPECT_TRUE(settings->allow_ads);
+  EXPECT_TRUE(settings->allow_http_upgradable_resource);
+  EXPECT_TRUE(settings->allow_referrers);
+
+  // Other origins are unaffected.
+  settings = brave_shields::GetShieldsSettings(map, GURL("http://brave2.com"));
+  EXPECT_TRUE(settings->brave_shields_enabled);
+  EXPECT_FALSE(settings->allow_ads);
+  EXPECT_FALSE(settings->allow_http_upgradable_resource);
+  EXPECT_FALSE(settings->allow_referrers);
+}
@@ -130,11 +130,17 @@ bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
 }
 
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
+  if (host_content_settings_map_)
+    host_content_settings_map_->RemoveObserver(this);
 }
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
     WebContents* web_contents)
-    : WebContentsObserver(web_contents) {
+    : WebContentsObserver(web_contents),
+      host_content_settings_map_(HostContentSettingsMapFactory::GetForProfile(
+          Profile::FromBrowserContext(web_contents->GetBrowserContext()))) {
+  if (host_content_settings_map_)
+    host_content_settings_map_->AddObserver(this);
 }
 
 void BraveShieldsWebContentsObserver::RenderFrameCreated(
@@ -209,6 +215,46 @@ GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
   return GURL();
 }
 
+// static
+scoped_refptr<const ShieldsSettings>
+BraveShieldsWebContentsObserver::GetShieldsSettingsForFrame(
+    HostContentSettingsMap* map,
+    const GURL& tab_origin,
+    int render_process_id,
+    int render_frame_id,
+    int frame_tree_node_id) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  WebContents* web_contents =
+      GetWebContents(render_process_id, render_frame_id, frame_tree_node_id);
+  if (web_contents) {
+    BraveShieldsWebContentsObserver* observer =
+        BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+    if (observer && observer->host_content_settings_map_ == map)
+      return observer->GetShieldsSettings(tab_origin);
+  }
+  return brave_shields::GetShieldsSettings(map, tab_origin);
+}
+
+scoped_refptr<const ShieldsSettings>
+BraveShieldsWebContentsObserver::GetShieldsSettings(const GURL& tab_origin) {
+  if (!shields_settings_ || shields_settings_->tab_origin != tab_origin) {
+    shields_settings_ = brave_shields::GetShieldsSettings(
+        host_content_settings_map_, tab_origin);
+  }
+  return shields_settings_;
+}
+
+void BraveShieldsWebContentsObserver::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  if (content_type == CONTENT_SETTINGS_TYPE_PLUGINS ||
+      content_type == CONTENT_SETTINGS_TYPE_DEFAULT) {
+    shields_settings_ = nullptr;
+  }
+}
+
 bool BraveShieldsWebContentsObserver::IsBlockedSubresource(
     const std::string& subresource) {
   return blocked_url_paths_.find(subresource) != blocked_url_paths_.end();
@@ -346,6 +392,11 @@ void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     blocked_url_paths_.clear();
   }
 
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    shields_settings_ = nullptr;
+  }
+
   navigation_handle->GetWebContents()->SendToAllFrames(
       new BraveFrameMsg_AllowScriptsOnce(
         MSG_ROUTING_NONE, allowed_script_origins_));
@@ -14,6 +14,8 @@
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "components/content_settings/core/browser/content_settings_observer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -21,12 +23,14 @@ namespace content {
 class WebContents;
 }
 
+class HostContentSettingsMap;
 class PrefRegistrySimple;
 
 namespace brave_shields {
 
 class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
-    public content::WebContentsUserData<BraveShieldsWebContentsObserver> {
+    public content::WebContentsUserData<BraveShieldsWebContentsObserver>,
+    public content_settings::Observer {
  public:
   explicit BraveShieldsWebContentsObserver(content::WebContents*);
   ~BraveShieldsWebContentsObserver() override;
@@ -44,6 +48,16 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
   static GURL GetTabURLFromRenderFrameInfo(int render_process_id,
                                            int render_frame_id,
                                            int render_frame_tree_node_id);
+  // Returns the shields settings snapshot shared by the frame tree the frame
+  // belongs to, resolving it only when the cached one is missing or was made
+  // for a different |tab_origin|. Falls back to a one-off lookup in |map| for
+  // frames that are not attached to an observed WebContents.
+  static scoped_refptr<const ShieldsSettings> GetShieldsSettingsForFrame(
+      HostContentSettingsMap* map,
+      const GURL& tab_origin,
+      int render_process_id,
+      int render_frame_id,
+      int frame_tree_node_id);
   void AllowScriptsOnce(const std::vector<std::string>& origins,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
@@ -85,6 +99,12 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::RenderFrameHost* render_frame_host,
       const base::string16& details);
 
+  // content_settings::Observer overrides.
+  void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
+                               const ContentSettingsPattern& secondary_pattern,
+                               ContentSettingsType content_type,
+                               const std::string& resource_identifier) override;
+
   // TODO(iefremov): Refactor this away or at least put into base::NoDestructor.
   // Protects global maps below from being concurrently written on the UI thread
   // and read on the IO thread.
@@ -94,6 +114,14 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+
+  scoped_refptr<const ShieldsSettings> GetShieldsSettings(
+      const GURL& tab_origin);
+
+  HostContentSettingsMap* host_content_settings_map_ = nullptr;
+  // Settings snapshot for the current top-level document, dropped on main
+  // frame navigations and whenever shields content settings change.
+  scoped_refptr<const ShieldsSettings> shields_settings_;
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
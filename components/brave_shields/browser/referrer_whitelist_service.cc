@@ -38,6 +38,24 @@ ReferrerWhitelistService::ReferrerWhitelist::ReferrerWhitelist(
   const ReferrerWhitelist& other) = default;
 ReferrerWhitelistService::ReferrerWhitelist::~ReferrerWhitelist() = default;
 
+ReferrerWhitelistService::ReferrerWhitelistSet::ReferrerWhitelistSet() =
+    default;
+ReferrerWhitelistService::ReferrerWhitelistSet::ReferrerWhitelistSet(
+  const ReferrerWhitelistSet& other) = default;
+ReferrerWhitelistService::ReferrerWhitelistSet::~ReferrerWhitelistSet() =
+    default;
+
+void ReferrerWhitelistService::ReferrerWhitelistSet::Add(
+    const ReferrerWhitelist& entry) {
+  first_party_index.Add(entry.first_party_pattern, entries.size());
+  entries.push_back(entry);
+}
+
+void ReferrerWhitelistService::ReferrerWhitelistSet::clear() {
+  entries.clear();
+  first_party_index.Clear();
+}
+
 bool ReferrerWhitelistService::IsWhitelisted(
     const GURL& first_party_origin, const GURL& subresource_url) const {
   if (BrowserThread::CurrentlyOn(BrowserThread::IO)) {
@@ -50,15 +68,15 @@ bool ReferrerWhitelistService::IsWhitelisted(
 }
 
 bool ReferrerWhitelistService::IsWhitelisted(
-    const std::vector<ReferrerWhitelist>& whitelist,
+    const ReferrerWhitelistSet& whitelist,
     const GURL& first_party_origin,
     const GURL& subresource_url) const {
-  for (auto rw : whitelist) {
-    if (rw.first_party_pattern.MatchesURL(first_party_origin)) {
-      for (auto subresource_pattern : rw.subresource_pattern_list) {
-        if (subresource_pattern.MatchesURL(subresource_url)) {
-          return true;
-        }
+  for (size_t id : whitelist.first_party_index.GetMatchingIds(
+           first_party_origin)) {
+    const ReferrerWhitelist& rw = whitelist.entries[id];
+    for (const auto& subresource_pattern : rw.subresource_pattern_list) {
+      if (subresource_pattern.MatchesURL(subresource_url)) {
+        return true;
       }
     }
   }
@@ -95,7 +113,7 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
           URLPattern::SCHEME_HTTP|URLPattern::SCHEME_HTTPS,
           subresource_value.GetString()));
       }
-      referrer_whitelist_.push_back(rw);
+      referrer_whitelist_.Add(rw);
     }
   }
 
@@ -107,7 +125,7 @@ void ReferrerWhitelistService::OnDATFileDataReady(std::string contents) {
 }
 
 void ReferrerWhitelistService::OnDATFileDataReadyOnIOThread(
-    std::vector<ReferrerWhitelist> whitelist) {
+    ReferrerWhitelistSet whitelist) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
   referrer_whitelist_io_thread_ = std::move(whitelist);
 }
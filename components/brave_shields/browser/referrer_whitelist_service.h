@@ -14,6 +14,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "brave/components/brave_component_updater/browser/local_data_files_observer.h"
+#include "brave/components/brave_shields/browser/url_pattern_host_index.h"
 #include "extensions/common/url_pattern.h"
 #include "url/gurl.h"
 
@@ -53,16 +54,30 @@ class ReferrerWhitelistService : public LocalDataFilesObserver {
     ~ReferrerWhitelist();
   };
 
-  bool IsWhitelisted(const std::vector<ReferrerWhitelist>& whitelist,
+  // The whitelist entries, with their first party patterns indexed by host.
+  struct ReferrerWhitelistSet {
+    std::vector<ReferrerWhitelist> entries;
+    // Ids are indices in |entries|.
+    URLPatternHostIndex first_party_index;
+    ReferrerWhitelistSet();
+    ReferrerWhitelistSet(const ReferrerWhitelistSet& other);
+    ~ReferrerWhitelistSet();
+
+    void Add(const ReferrerWhitelist& entry);
+    size_t size() const { return entries.size(); }
+    void clear();
+  };
+
+  bool IsWhitelisted(const ReferrerWhitelistSet& whitelist,
                      const GURL& first_party_origin,
                      const GURL& subresource_url) const;
   void OnDATFileDataReady(std::string contents);
-  void OnDATFileDataReadyOnIOThread(std::vector<ReferrerWhitelist> whitelist);
+  void OnDATFileDataReadyOnIOThread(ReferrerWhitelistSet whitelist);
 
   typedef std::vector<URLPattern> URLPatternList;
 
-  std::vector<ReferrerWhitelist> referrer_whitelist_;
-  std::vector<ReferrerWhitelist> referrer_whitelist_io_thread_;
+  ReferrerWhitelistSet referrer_whitelist_;
+  ReferrerWhitelistSet referrer_whitelist_io_thread_;
 
   SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<ReferrerWhitelistService> weak_factory_;
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/url_pattern_host_index.h"
+
+#include <algorithm>
+
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+URLPatternHostIndex::URLPatternHostIndex() = default;
+URLPatternHostIndex::URLPatternHostIndex(const URLPatternHostIndex& other) =
+    default;
+URLPatternHostIndex& URLPatternHostIndex::operator=(
+    const URLPatternHostIndex& other) = default;
+URLPatternHostIndex::~URLPatternHostIndex() = default;
+
+void URLPatternHostIndex::Add(const URLPattern& pattern, size_t id) {
+  if (pattern.host().empty() && pattern.match_subdomains()) {
+    any_host_patterns_.emplace_back(pattern, id);
+  } else if (pattern.match_subdomains()) {
+    subdomain_patterns_[pattern.host()].emplace_back(pattern, id);
+  } else {
+    host_patterns_[pattern.host()].emplace_back(pattern, id);
+  }
+}
+
+void URLPatternHostIndex::Clear() {
+  host_patterns_.clear();
+  subdomain_patterns_.clear();
+  any_host_patterns_.clear();
+}
+
+std::vector<size_t> URLPatternHostIndex::GetMatchingIds(
+    const GURL& url) const {
+  return GetIds(url, true);
+}
+
+std::vector<size_t> URLPatternHostIndex::GetCandidateIds(
+    const GURL& url) const {
+  return GetIds(url, false);
+}
+
+std::vector<size_t> URLPatternHostIndex::GetIds(const GURL& url,
+                                                bool match_url) const {
+  std::vector<size_t> ids;
+  // Patterns ignore a trailing dot in the host, so does the lookup.
+  std::string host = url.host();
+  if (!host.empty() && host.back() == '.')
+    host.pop_back();
+
+  auto it = host_patterns_.find(host);
+  if (it != host_patterns_.end())
+    AddIds(it->second, url, match_url, &ids);
+
+  // A subdomain pattern for "example.com" can match "example.com" and any
+  // "*.example.com" host, so look up every suffix starting at a label.
+  if (!subdomain_patterns_.empty()) {
+    for (size_t pos = 0; pos != std::string::npos;) {
+      it = subdomain_patterns_.find(host.substr(pos));
+      if (it != subdomain_patterns_.end())
+        AddIds(it->second, url, match_url, &ids);
+      pos = host.find('.', pos);
+      if (pos != std::string::npos)
+        ++pos;
+    }
+  }
+
+  AddIds(any_host_patterns_, url, match_url, &ids);
+
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+void URLPatternHostIndex::AddIds(const PatternList& patterns,
+                                 const GURL& url,
+                                 bool match_url,
+                                 std::vector<size_t>* ids) const {
+  for (const auto& pattern : patterns) {
+    if (!match_url || pattern.first.MatchesURL(url))
+      ids->push_back(pattern.second);
+  }
+}
+
+}  // namespace brave_shields
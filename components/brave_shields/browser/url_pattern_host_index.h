@@ -0,0 +1,62 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_URL_PATTERN_HOST_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_URL_PATTERN_HOST_INDEX_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// A list of URL patterns, each one tagged with an id, indexed by the host
+// they match. Looking up a URL only runs the patterns which can match its
+// host, instead of every pattern of the list.
+class URLPatternHostIndex {
+ public:
+  URLPatternHostIndex();
+  URLPatternHostIndex(const URLPatternHostIndex& other);
+  URLPatternHostIndex& operator=(const URLPatternHostIndex& other);
+  ~URLPatternHostIndex();
+
+  void Add(const URLPattern& pattern, size_t id);
+  void Clear();
+
+  // Returns the ids of the patterns matching |url|, in ascending order and
+  // without duplicates.
+  std::vector<size_t> GetMatchingIds(const GURL& url) const;
+  // Same, but only requires the host of the patterns to match, as
+  // |URLPattern::MatchesHost()| does. Callers can run their own matching on
+  // these candidates.
+  std::vector<size_t> GetCandidateIds(const GURL& url) const;
+
+ private:
+  using PatternList = std::vector<std::pair<URLPattern, size_t>>;
+
+  // Returns the ids of the patterns for the host of |url| which also match
+  // |url| if |match_url| is true.
+  std::vector<size_t> GetIds(const GURL& url, bool match_url) const;
+  void AddIds(const PatternList& patterns,
+              const GURL& url,
+              bool match_url,
+              std::vector<size_t>* ids) const;
+
+  // Patterns for exactly one host, and patterns for a host and all of its
+  // subdomains, both keyed by that host.
+  std::unordered_map<std::string, PatternList> host_patterns_;
+  std::unordered_map<std::string, PatternList> subdomain_patterns_;
+  // Patterns matching any host.
+  PatternList any_host_patterns_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_URL_PATTERN_HOST_INDEX_H_
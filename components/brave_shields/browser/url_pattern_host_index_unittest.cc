@@ -0,0 +1,50 @@
+/* Copyright (c) 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/url_pattern_host_index.h"
+
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::URLPatternHostIndex;
+using ::testing::ElementsAre;
+
+namespace {
+
+const int kValidSchemes = URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+}  // namespace
+
+TEST(URLPatternHostIndexTest, MatchesByHost) {
+  URLPatternHostIndex index;
+  index.Add(URLPattern(kValidSchemes, "https://brave.com/*"), 0);
+  index.Add(URLPattern(kValidSchemes, "*://*.example.com/*"), 1);
+  index.Add(URLPattern(kValidSchemes, "https://www.example.com/path/*"), 2);
+  index.Add(URLPattern(kValidSchemes, "<all_urls>"), 3);
+  index.Add(URLPattern(kValidSchemes, "https://*/*"), 4);
+
+  EXPECT_THAT(index.GetMatchingIds(GURL("https://brave.com/")),
+              ElementsAre(0, 3, 4));
+  EXPECT_THAT(index.GetMatchingIds(GURL("http://brave.com/")),
+              ElementsAre(3));
+  EXPECT_THAT(index.GetMatchingIds(GURL("http://sub.brave.com/")),
+              ElementsAre(3));
+  EXPECT_THAT(index.GetMatchingIds(GURL("http://example.com/")),
+              ElementsAre(1, 3));
+  EXPECT_THAT(index.GetMatchingIds(GURL("https://a.b.example.com/")),
+              ElementsAre(1, 3, 4));
+  EXPECT_THAT(index.GetMatchingIds(GURL("https://www.example.com/path/a")),
+              ElementsAre(1, 2, 3, 4));
+  EXPECT_THAT(index.GetMatchingIds(GURL("https://www.example.com/other")),
+              ElementsAre(1, 3, 4));
+  EXPECT_THAT(index.GetMatchingIds(GURL("https://notexample.com/")),
+              ElementsAre(3, 4));
+
+  index.Clear();
+  EXPECT_TRUE(index.GetMatchingIds(GURL("https://brave.com/")).empty());
+}
@@ -0,0 +1,156 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+
+#include <algorithm>
+
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "ui/base/models/tree_node_iterator.h"
+#include "url/gurl.h"
+
+namespace brave_sync {
+
+namespace {
+
+const char kObjectId[] = "object_id";
+
+// Returns the child index of each node on the path from the root to |node|.
+std::vector<int> GetTreePath(const bookmarks::BookmarkNode* node) {
+  std::vector<int> path;
+  for (; node->parent(); node = node->parent())
+    path.push_back(node->parent()->GetIndexOf(node));
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+// Returns true when |a| is visited before |b| in a pre-order walk of the
+// bookmark tree.
+bool PrecedesInTreeOrder(const bookmarks::BookmarkNode* a,
+                         const bookmarks::BookmarkNode* b) {
+  return GetTreePath(a) < GetTreePath(b);
+}
+
+}  // namespace
+
+BookmarkObjectIdIndex::BookmarkObjectIdIndex(bookmarks::BookmarkModel* model)
+    : model_(model) {
+  DCHECK(model_);
+  model_->AddObserver(this);
+  if (model_->loaded())
+    Rebuild();
+}
+
+BookmarkObjectIdIndex::~BookmarkObjectIdIndex() {
+  if (model_)
+    model_->RemoveObserver(this);
+}
+
+const bookmarks::BookmarkNode* BookmarkObjectIdIndex::Find(
+    const std::string& object_id) const {
+  if (object_id.empty())
+    return nullptr;
+  auto it = nodes_.find(object_id);
+  if (it == nodes_.end())
+    return nullptr;
+  // Duplicates are rare and may have been moved since they were indexed, so
+  // they are ordered on lookup, as the linear lookup this replaces did.
+  const auto& nodes = it->second;
+  if (nodes.size() == 1)
+    return nodes.front();
+  return *std::min_element(nodes.begin(), nodes.end(), &PrecedesInTreeOrder);
+}
+
+void BookmarkObjectIdIndex::Rebuild() {
+  nodes_.clear();
+  AddSubtree(model_->root_node());
+}
+
+void BookmarkObjectIdIndex::AddSubtree(const bookmarks::BookmarkNode* node) {
+  Add(node);
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    Add(iterator.Next());
+}
+
+void BookmarkObjectIdIndex::RemoveSubtree(
+    const bookmarks::BookmarkNode* node) {
+  Remove(node);
+  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(node);
+  while (iterator.has_next())
+    Remove(iterator.Next());
+}
+
+void BookmarkObjectIdIndex::Add(const bookmarks::BookmarkNode* node) {
+  std::string object_id;
+  if (!node->GetMetaInfo(kObjectId, &object_id) || object_id.empty())
+    return;
+  auto& nodes = nodes_[object_id];
+  if (std::find(nodes.begin(), nodes.end(), node) == nodes.end())
+    nodes.push_back(node);
+}
+
+void BookmarkObjectIdIndex::Remove(const bookmarks::BookmarkNode* node) {
+  std::string object_id;
+  if (!node->GetMetaInfo(kObjectId, &object_id) || object_id.empty())
+    return;
+  auto it = nodes_.find(object_id);
+  if (it == nodes_.end())
+    return;
+  auto& nodes = it->second;
+  nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+  if (nodes.empty())
+    nodes_.erase(it);
+}
+
+void BookmarkObjectIdIndex::BookmarkModelChanged() {}
+
+void BookmarkObjectIdIndex::BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                                                bool ids_reassigned) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::BookmarkModelBeingDeleted(
+    bookmarks::BookmarkModel* model) {
+  nodes_.clear();
+  model_->RemoveObserver(this);
+  model_ = nullptr;
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeAdded(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t index) {
+  AddSubtree(parent->children()[index].get());
+}
+
+void BookmarkObjectIdIndex::BookmarkNodeRemoved(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* parent,
+    size_t old_index,
+    const bookmarks::BookmarkNode* node,
+    const std::set<GURL>& no_longer_bookmarked) {
+  RemoveSubtree(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkAllUserNodesRemoved(
+    bookmarks::BookmarkModel* model,
+    const std::set<GURL>& removed_urls) {
+  Rebuild();
+}
+
+void BookmarkObjectIdIndex::OnWillChangeBookmarkMetaInfo(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  Remove(node);
+}
+
+void BookmarkObjectIdIndex::BookmarkMetaInfoChanged(
+    bookmarks::BookmarkModel* model,
+    const bookmarks::BookmarkNode* node) {
+  Add(node);
+}
+
+}  // namespace brave_sync
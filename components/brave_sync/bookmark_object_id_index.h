@@ -0,0 +1,80 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "components/bookmarks/browser/base_bookmark_model_observer.h"
+
+class GURL;
+
+namespace bookmarks {
+class BookmarkModel;
+class BookmarkNode;
+}  // namespace bookmarks
+
+namespace brave_sync {
+
+// Keeps an "object_id" meta info -> nodes map of |model| up to date through
+// bookmark model notifications, so sync records can be resolved to nodes
+// without walking the whole bookmark tree.
+class BookmarkObjectIdIndex : public bookmarks::BaseBookmarkModelObserver {
+ public:
+  explicit BookmarkObjectIdIndex(bookmarks::BookmarkModel* model);
+  ~BookmarkObjectIdIndex() override;
+
+  // Returns nullptr when no node has |object_id| or the model is not loaded.
+  // When several nodes share |object_id| the first one in tree order is
+  // returned.
+  const bookmarks::BookmarkNode* Find(const std::string& object_id) const;
+
+  size_t size() const { return nodes_.size(); }
+
+ private:
+  void Rebuild();
+  void AddSubtree(const bookmarks::BookmarkNode* node);
+  void RemoveSubtree(const bookmarks::BookmarkNode* node);
+  void Add(const bookmarks::BookmarkNode* node);
+  void Remove(const bookmarks::BookmarkNode* node);
+
+  // bookmarks::BaseBookmarkModelObserver overrides:
+  void BookmarkModelChanged() override;
+  void BookmarkModelLoaded(bookmarks::BookmarkModel* model,
+                           bool ids_reassigned) override;
+  void BookmarkModelBeingDeleted(bookmarks::BookmarkModel* model) override;
+  void BookmarkNodeAdded(bookmarks::BookmarkModel* model,
+                         const bookmarks::BookmarkNode* parent,
+                         size_t index) override;
+  void BookmarkNodeRemoved(bookmarks::BookmarkModel* model,
+                           const bookmarks::BookmarkNode* parent,
+                           size_t old_index,
+                           const bookmarks::BookmarkNode* node,
+                           const std::set<GURL>& no_longer_bookmarked) override;
+  void BookmarkAllUserNodesRemoved(
+      bookmarks::BookmarkModel* model,
+      const std::set<GURL>& removed_urls) override;
+  void OnWillChangeBookmarkMetaInfo(
+      bookmarks::BookmarkModel* model,
+      const bookmarks::BookmarkNode* node) override;
+  void BookmarkMetaInfoChanged(bookmarks::BookmarkModel* model,
+                               const bookmarks::BookmarkNode* node) override;
+
+  bookmarks::BookmarkModel* model_;  // Not owned
+  // Nodes holding each object_id, in no particular order.
+  std::unordered_map<std::string, std::vector<const bookmarks::BookmarkNode*>>
+      nodes_;
+
+  DISALLOW_COPY_AND_ASSIGN(BookmarkObjectIdIndex);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_BOOKMARK_OBJECT_ID_INDEX_H_
@@ -0,0 +1,135 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+
+#include "base/strings/utf_string_conversions.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using bookmarks::BookmarkModel;
+using bookmarks::BookmarkNode;
+
+namespace brave_sync {
+
+class BookmarkObjectIdIndexTest : public testing::Test {
+ public:
+  BookmarkObjectIdIndexTest()
+      : model_(bookmarks::TestBookmarkClient::CreateModel()) {}
+  ~BookmarkObjectIdIndexTest() override {}
+
+ protected:
+  const BookmarkNode* AddURL(const BookmarkNode* parent,
+                             const std::string& object_id) {
+    const BookmarkNode* node =
+        model_->AddURL(parent, parent->children().size(),
+                       base::ASCIIToUTF16(object_id),
+                       GURL("https://" + object_id + ".com/"));
+    model_->SetNodeMetaInfo(node, "object_id", object_id);
+    return node;
+  }
+
+  content::TestBrowserThreadBundle thread_bundle_;
+  std::unique_ptr<BookmarkModel> model_;
+};
+
+TEST_F(BookmarkObjectIdIndexTest, IndexesExistingNodes) {
+  const BookmarkNode* a = AddURL(model_->bookmark_bar_node(), "a");
+  const BookmarkNode* b = AddURL(model_->other_node(), "b");
+
+  BookmarkObjectIdIndex index(model_.get());
+  EXPECT_EQ(a, index.Find("a"));
+  EXPECT_EQ(b, index.Find("b"));
+  EXPECT_EQ(nullptr, index.Find("c"));
+  EXPECT_EQ(nullptr, index.Find(""));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, TracksAddAndRemove) {
+  BookmarkObjectIdIndex index(model_.get());
+  const BookmarkNode* folder = model_->AddFolder(
+      model_->bookmark_bar_node(), 0, base::ASCIIToUTF16("folder"));
+  model_->SetNodeMetaInfo(folder, "object_id", "folder");
+  const BookmarkNode* a = AddURL(folder, "a");
+  const BookmarkNode* b = AddURL(folder, "b");
+
+  EXPECT_EQ(folder, index.Find("folder"));
+  EXPECT_EQ(a, index.Find("a"));
+  EXPECT_EQ(b, index.Find("b"));
+
+  // Moving keeps the nodes indexed.
+  model_->Move(a, model_->other_node(), 0);
+  EXPECT_EQ(a, index.Find("a"));
+
+  model_->Remove(a);
+  EXPECT_EQ(nullptr, index.Find("a"));
+
+  // Removing a folder drops its descendants.
+  model_->Remove(folder);
+  EXPECT_EQ(nullptr, index.Find("folder"));
+  EXPECT_EQ(nullptr, index.Find("b"));
+  EXPECT_EQ(0u, index.size());
+}
+
+TEST_F(BookmarkObjectIdIndexTest, TracksMetaInfoChanges) {
+  BookmarkObjectIdIndex index(model_.get());
+  const BookmarkNode* a = AddURL(model_->bookmark_bar_node(), "a");
+  EXPECT_EQ(a, index.Find("a"));
+
+  model_->SetNodeMetaInfo(a, "object_id", "a2");
+  EXPECT_EQ(nullptr, index.Find("a"));
+  EXPECT_EQ(a, index.Find("a2"));
+
+  // Unrelated meta info keeps the entry.
+  model_->SetNodeMetaInfo(a, "order", "1.0.1.1");
+  EXPECT_EQ(a, index.Find("a2"));
+
+  model_->DeleteNodeMetaInfo(a, "object_id");
+  EXPECT_EQ(nullptr, index.Find("a2"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, RemoveAllUserBookmarks) {
+  BookmarkObjectIdIndex index(model_.get());
+  AddURL(model_->bookmark_bar_node(), "a");
+  AddURL(model_->other_node(), "b");
+  model_->SetNodeMetaInfo(model_->other_node(), "object_id", "other");
+
+  model_->RemoveAllUserBookmarks();
+  EXPECT_EQ(nullptr, index.Find("a"));
+  EXPECT_EQ(nullptr, index.Find("b"));
+  EXPECT_EQ(model_->other_node(), index.Find("other"));
+}
+
+TEST_F(BookmarkObjectIdIndexTest, DuplicateObjectIds) {
+  const BookmarkNode* other = AddURL(model_->other_node(), "a");
+  BookmarkObjectIdIndex index(model_.get());
+  EXPECT_EQ(other, index.Find("a"));
+
+  // A node added later but earlier in tree order wins.
+  const BookmarkNode* bar = AddURL(model_->bookmark_bar_node(), "a");
+  EXPECT_EQ(bar, index.Find("a"));
+  EXPECT_EQ(1u, index.size());
+
+  // So does a node moved ahead of the others.
+  const BookmarkNode* mobile = AddURL(model_->mobile_node(), "a");
+  EXPECT_EQ(bar, index.Find("a"));
+  model_->Move(mobile, model_->bookmark_bar_node(), 0);
+  EXPECT_EQ(mobile, index.Find("a"));
+
+  // Removing one of the nodes keeps the others indexed.
+  model_->Remove(mobile);
+  EXPECT_EQ(bar, index.Find("a"));
+  model_->SetNodeMetaInfo(bar, "object_id", "b");
+  EXPECT_EQ(other, index.Find("a"));
+  EXPECT_EQ(bar, index.Find("b"));
+  model_->Remove(other);
+  EXPECT_EQ(nullptr, index.Find("a"));
+  EXPECT_EQ(1u, index.size());
+}
+
+}  // namespace brave_sync
@@ -6,7 +6,9 @@
 #include "brave/components/brave_sync/bookmark_order_util.h"
 
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 
 namespace brave_sync {
 
@@ -19,6 +21,33 @@ bool CompareOrder(const std::vector<int>& vec_left,
                                       vec_right.begin(), vec_right.end());
 }
 
+// Walks the numbers of an order string the same way |OrderToIntVect| splits
+// it, but without allocating, so comparisons stay cheap.
+class OrderSegmentIterator {
+ public:
+  explicit OrderSegmentIterator(base::StringPiece order) : rest_(order) {}
+
+  bool Next(int* value) {
+    while (!rest_.empty()) {
+      const size_t dot = rest_.find('.');
+      base::StringPiece segment = rest_.substr(0, dot);
+      rest_ = dot == base::StringPiece::npos ? base::StringPiece()
+                                             : rest_.substr(dot + 1);
+      segment = base::TrimWhitespaceASCII(segment, base::TRIM_ALL);
+      if (segment.empty())
+        continue;
+      bool result = base::StringToInt(segment, value);
+      CHECK(result);
+      CHECK_GE(*value, 0);
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  base::StringPiece rest_;
+};
+
 }  // namespace
 
 std::vector<int> OrderToIntVect(const std::string& s) {
@@ -55,11 +84,21 @@ std::string ToOrderString(const std::vector<int>& vec_int) {
 
 bool CompareOrder(const std::string& left, const std::string& right) {
   // Return: true if left <  right
-  // Split each and compare as int vectors
-  std::vector<int> vec_left = OrderToIntVect(left);
-  std::vector<int> vec_right = OrderToIntVect(right);
-
-  return CompareOrder(vec_left, vec_right);
+  // Compare numbers pairwise, same as comparing the int vectors
+  OrderSegmentIterator left_it(left);
+  OrderSegmentIterator right_it(right);
+  int left_value = 0;
+  int right_value = 0;
+  while (true) {
+    const bool has_left = left_it.Next(&left_value);
+    const bool has_right = right_it.Next(&right_value);
+    if (!has_right)
+      return false;
+    if (!has_left)
+      return true;
+    if (left_value != right_value)
+      return left_value < right_value;
+  }
 }
 
 namespace {
@@ -5,6 +5,9 @@
 
 #include "brave/components/brave_sync/bookmark_order_util.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace brave_sync {
@@ -80,6 +83,24 @@ TEST(BookmarkOrderUtilTest, CompareOrder) {
   EXPECT_TRUE(CompareOrder("2.0.8.11", "2.0.8.11.1"));
 }
 
+TEST(BookmarkOrderUtilTest, CompareOrder_MatchesIntVectCompare) {
+  const char* orders[] = {"",        "1",         "1.1",     "1.0.1",
+                          "2",       "11",        "2.0.8",   "2.0.8.0.1",
+                          "2.0.8.1", "2.0.8.0.0.1", "..5.",  "1..2",
+                          "1.2.",    "1.10",      "1.9.99"};
+  for (const char* left : orders) {
+    for (const char* right : orders) {
+      const std::vector<int> vec_left = OrderToIntVect(left);
+      const std::vector<int> vec_right = OrderToIntVect(right);
+      EXPECT_EQ(std::lexicographical_compare(vec_left.begin(), vec_left.end(),
+                                             vec_right.begin(),
+                                             vec_right.end()),
+                CompareOrder(left, right))
+          << left << " < " << right;
+    }
+  }
+}
+
 TEST(BookmarkOrderUtilTest, GetOrder) {
   // Ported from
   // https://github.com/brave/sync/blob/staging/test/client/bookmarkUtil.js
@@ -13,12 +13,14 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "brave/components/brave_sync/bookmark_object_id_index.h"
 #include "brave/components/brave_sync/brave_sync_prefs.h"
 #include "brave/components/brave_sync/brave_sync_service_observer.h"
 #include "brave/components/brave_sync/client/brave_sync_client_impl.h"
 #include "brave/components/brave_sync/crypto/crypto.h"
 #include "brave/components/brave_sync/jslib_const.h"
 #include "brave/components/brave_sync/jslib_messages.h"
+#include "brave/components/brave_sync/records_to_resend_queue.h"
 #include "brave/components/brave_sync/settings.h"
 #include "brave/components/brave_sync/sync_devices.h"
 #include "brave/components/brave_sync/syncer_helper.h"
@@ -32,7 +34,6 @@
 #include "components/sync/engine_impl/syncer.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/network_interfaces.h"
-#include "ui/base/models/tree_node_iterator.h"
 
 namespace brave_sync {
 
@@ -101,21 +102,6 @@ RecordsListPtr CreateDeviceCreationRecordExtension(
   return records;
 }
 
-const bookmarks::BookmarkNode* FindByObjectId(bookmarks::BookmarkModel* model,
-                                              const std::string& object_id) {
-  ui::TreeNodeIterator<const bookmarks::BookmarkNode> iterator(
-      model->root_node());
-  while (iterator.has_next()) {
-    const bookmarks::BookmarkNode* node = iterator.Next();
-    std::string node_object_id;
-    node->GetMetaInfo("object_id", &node_object_id);
-
-    if (!node_object_id.empty() && object_id == node_object_id)
-      return node;
-  }
-  return nullptr;
-}
-
 std::unique_ptr<SyncRecord> CreateDeleteBookmarkByObjectId(
     const prefs::Prefs* brave_sync_prefs,
     const std::string& object_id) {
@@ -170,6 +156,9 @@ BraveProfileSyncServiceImpl::BraveProfileSyncServiceImpl(Profile* profile,
   brave_sync_words_ = std::string();
   brave_sync_prefs_ =
       std::make_unique<prefs::Prefs>(sync_client_->GetPrefService());
+  records_to_resend_ = std::make_unique<RecordsToResendQueue>(
+      brave_sync_prefs_.get(), kMaxSendRetries,
+      &BraveProfileSyncServiceImpl::GetRetryExponentialWaitAmount);
 
   // Moniter syncs prefs required in GetSettingsAndDevices
   brave_pref_change_registrar_.Init(sync_client_->GetPrefService());
@@ -199,6 +188,8 @@ BraveProfileSyncServiceImpl::BraveProfileSyncServiceImpl(Profile* profile,
                  base::Unretained(this)));
 
   model_ = BookmarkModelFactory::GetForBrowserContext(profile);
+  if (model_)
+    object_id_index_ = std::make_unique<BookmarkObjectIdIndex>(model_);
 
   if (!brave_sync_prefs_->GetSeed().empty() &&
       !brave_sync_prefs_->GetThisDeviceName().empty()) {
@@ -384,6 +375,7 @@ void BraveProfileSyncServiceImpl::OnSyncDebug(const std::string& message) {
 void BraveProfileSyncServiceImpl::OnSyncSetupError(const std::string& error) {
   if (brave_sync_initializing_) {
     brave_sync_prefs_->Clear();
+    records_to_resend_->Reset();
     brave_sync_initializing_ = false;
   }
   NotifySyncSetupError(error);
@@ -653,6 +645,7 @@ void BraveProfileSyncServiceImpl::ResetSyncInternal() {
   brave_sync_prefs_->SetPrevSeed(brave_sync_prefs_->GetSeed());
 
   brave_sync_prefs_->Clear();
+  records_to_resend_->Reset();
 
   brave_sync_configured_ = false;
   brave_sync_initialized_ = false;
@@ -745,11 +738,22 @@ BraveProfileSyncServiceImpl::BookmarkNodeToSyncBookmark(
   return record;
 }
 
+const bookmarks::BookmarkNode* BraveProfileSyncServiceImpl::FindByObjectId(
+    const std::string& object_id) const {
+  if (!object_id_index_)
+    return nullptr;
+  return object_id_index_->Find(object_id);
+}
+
 void BraveProfileSyncServiceImpl::SaveSyncEntityInfo(
     const jslib::SyncRecord* record) {
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   // no need to save for DELETE
   if (node) {
+    // Write all keys at once so observers are notified a single time.
+    bookmarks::BookmarkNode::MetaInfoMap meta_info_map;
+    if (node->GetMetaInfoMap())
+      meta_info_map = *node->GetMetaInfoMap();
     auto& bookmark = record->GetBookmark();
     for (auto& meta_info : bookmark.metaInfo) {
       if (meta_info.key == "version") {
@@ -757,11 +761,12 @@ void BraveProfileSyncServiceImpl::SaveSyncEntityInfo(
         int64_t version;
         bool result = base::StringToInt64(meta_info.value, &version);
         DCHECK(result);
-        model_->SetNodeMetaInfo(node, meta_info.key, std::to_string(++version));
+        meta_info_map[meta_info.key] = std::to_string(++version);
       } else {
-        model_->SetNodeMetaInfo(node, meta_info.key, meta_info.value);
+        meta_info_map[meta_info.key] = meta_info.value;
       }
     }
+    model_->SetNodeMetaInfoMap(node, meta_info_map);
   }
 }
 
@@ -770,7 +775,7 @@ void BraveProfileSyncServiceImpl::LoadSyncEntityInfo(
   auto* bookmark = record->mutable_bookmark();
   if (!bookmark->metaInfo.empty())
     return;
-  auto* node = FindByObjectId(model_, record->objectId);
+  auto* node = FindByObjectId(record->objectId);
   if (node) {
     AddSyncEntityInfo(bookmark, node, "originator_cache_guid");
     AddSyncEntityInfo(bookmark, node, "originator_client_item_id");
@@ -792,12 +797,12 @@ void BraveProfileSyncServiceImpl::CreateResolveList(
     // Ignore records from ourselves to avoid mess on merge
     if (record->deviceId == this_device_id) {
       // Remove Acked sent records
-      brave_sync_prefs_->RemoveFromRecordsToResend(record->objectId);
+      records_to_resend_->Remove(record->objectId);
       continue;
     }
     auto resolved_record = std::make_unique<SyncRecordAndExisting>();
     resolved_record->first = SyncRecord::Clone(*record);
-    auto* node = FindByObjectId(model_, record->objectId);
+    auto* node = FindByObjectId(record->objectId);
     if (node) {
       resolved_record->second = BookmarkNodeToSyncBookmark(node);
     }
@@ -1011,52 +1016,22 @@ void BraveProfileSyncServiceImpl::SendSyncRecords(
   if (category_name == kBookmarks) {
     for (auto& record : *records) {
       SaveSyncEntityInfo(record.get());
-      std::unique_ptr<base::DictionaryValue> meta =
-          std::make_unique<base::DictionaryValue>();
-      meta->SetInteger("send_retry_number", 0);
-      meta->SetDouble("sync_timestamp", record->syncTimestamp.ToJsTime());
-      brave_sync_prefs_->AddToRecordsToResend(record->objectId,
-                                              std::move(meta));
     }
+    records_to_resend_->Add(*records);
   }
 }
 
 void BraveProfileSyncServiceImpl::ResendSyncRecords(
     const std::string& category_name) {
   if (category_name == kBookmarks) {
-    RecordsListPtr records = std::make_unique<RecordsList>();
-    std::vector<std::string> records_to_resend =
-        brave_sync_prefs_->GetRecordsToResend();
+    // Only records whose wait has expired are taken from the queue.
+    const std::vector<std::string> records_to_resend =
+        records_to_resend_->TakeDue(base::Time::Now());
     if (records_to_resend.empty())
       return;
+    RecordsListPtr records = std::make_unique<RecordsList>();
     for (auto& object_id : records_to_resend) {
-      auto* node = FindByObjectId(model_, object_id);
-
-      // Check resend interval
-      const base::DictionaryValue* meta =
-          brave_sync_prefs_->GetRecordToResendMeta(object_id);
-      DCHECK(meta);
-      int current_retry_number = kMaxSendRetries;
-      meta->GetInteger("send_retry_number", &current_retry_number);
-      DCHECK_GE(current_retry_number, 0);
-      double sync_timestamp = 0;
-      meta->GetDouble("sync_timestamp", &sync_timestamp);
-      DCHECK(!base::Time::FromJsTime(sync_timestamp).is_null());
-
-      if ((base::Time::Now() - base::Time::FromJsTime(sync_timestamp)) <
-          GetRetryExponentialWaitAmount(current_retry_number))
-        continue;
-
-      // Increase retry number
-      if (++current_retry_number > kMaxSendRetries)
-        current_retry_number = kMaxSendRetries;
-      std::unique_ptr<base::DictionaryValue> new_meta =
-          base::DictionaryValue::From(
-              std::make_unique<base::Value>(meta->Clone()));
-      new_meta->SetInteger("send_retry_number", current_retry_number);
-      new_meta->SetDouble("sync_timestamp", base::Time::Now().ToJsTime());
-      brave_sync_prefs_->SetRecordToResendMeta(object_id, std::move(new_meta));
-
+      auto* node = FindByObjectId(object_id);
       if (node) {
         records->push_back(BookmarkNodeToSyncBookmark(node));
       } else {
@@ -1064,8 +1039,7 @@ void BraveProfileSyncServiceImpl::ResendSyncRecords(
             CreateDeleteBookmarkByObjectId(brave_sync_prefs_.get(), object_id));
       }
     }
-    if (!records->empty())
-      brave_sync_client_->SendSyncRecords(category_name, *records);
+    brave_sync_client_->SendSyncRecords(category_name, *records);
   }
 }
 
@@ -48,6 +48,9 @@ namespace prefs {
 class Prefs;
 }  // namespace prefs
 
+class BookmarkObjectIdIndex;
+class RecordsToResendQueue;
+
 class BraveProfileSyncServiceImpl
     : public BraveProfileSyncService,
       public BraveSyncService,
@@ -171,6 +174,9 @@ class BraveProfileSyncServiceImpl
 
   void SetPermanentNodesOrder(const std::string& base_order);
 
+  const bookmarks::BookmarkNode* FindByObjectId(
+      const std::string& object_id) const;
+
   std::unique_ptr<jslib::SyncRecord> BookmarkNodeToSyncBookmark(
       const bookmarks::BookmarkNode* node);
   // These SyncEntityInfo is for legacy device who doesn't send meta info for
@@ -198,6 +204,8 @@ class BraveProfileSyncServiceImpl
   static const int kMaxSendRetries;
 
   std::unique_ptr<brave_sync::prefs::Prefs> brave_sync_prefs_;
+  // Sent bookmark records waiting for confirmation, by next retry time.
+  std::unique_ptr<RecordsToResendQueue> records_to_resend_;
   // True when is in active sync chain
   bool brave_sync_configured_ = false;
 
@@ -219,6 +227,8 @@ class BraveProfileSyncServiceImpl
   PrefChangeRegistrar brave_pref_change_registrar_;
 
   bookmarks::BookmarkModel* model_ = nullptr;
+  // Resolves sync record object ids to nodes of |model_|.
+  std::unique_ptr<BookmarkObjectIdIndex> object_id_index_;
 
   std::unique_ptr<BraveSyncClient> brave_sync_client_;
 
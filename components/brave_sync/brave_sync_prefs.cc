@@ -212,11 +212,14 @@ std::vector<std::string> Prefs::GetRecordsToResend() const {
   return result;
 }
 
-void Prefs::AddToRecordsToResend(const std::string& object_id,
-                                 std::unique_ptr<base::DictionaryValue> meta) {
+void Prefs::AddToRecordsToResend(const base::DictionaryValue& records_meta) {
   ListPrefUpdate list_update(pref_service_, kSyncRecordsToResend);
-  list_update->GetList().emplace_back(object_id);
-  SetRecordToResendMeta(object_id, std::move(meta));
+  DictionaryPrefUpdate dict_update(pref_service_, kSyncRecordsToResendMeta);
+  for (const auto& item : records_meta.DictItems()) {
+    if (!dict_update->FindKey(item.first))
+      list_update->GetList().emplace_back(item.first);
+    dict_update->SetKey(item.first, item.second.Clone());
+  }
 }
 
 void Prefs::RemoveFromRecordsToResend(const std::string& object_id) {
@@ -238,10 +241,10 @@ const base::DictionaryValue* Prefs::GetRecordToResendMeta(
   return meta;
 }
 
-void Prefs::SetRecordToResendMeta(const std::string& object_id,
-                                  std::unique_ptr<base::DictionaryValue> meta) {
+void Prefs::SetRecordsToResendMeta(const base::DictionaryValue& records_meta) {
   DictionaryPrefUpdate dict_update(pref_service_, kSyncRecordsToResendMeta);
-  dict_update->SetDictionary(object_id, std::move(meta));
+  for (const auto& item : records_meta.DictItems())
+    dict_update->SetKey(item.first, item.second.Clone());
 }
 
 void Prefs::Clear() {
@@ -115,13 +115,12 @@ class Prefs {
   void SetMigratedBookmarksVersion(const int);
 
   std::vector<std::string> GetRecordsToResend() const;
-  void AddToRecordsToResend(const std::string& object_id,
-                            std::unique_ptr<base::DictionaryValue> meta);
+  // |records_meta| maps object ids to their meta.
+  void AddToRecordsToResend(const base::DictionaryValue& records_meta);
   void RemoveFromRecordsToResend(const std::string& object_id);
   const base::DictionaryValue* GetRecordToResendMeta(
       const std::string& object_id) const;
-  void SetRecordToResendMeta(const std::string& object_id,
-                             std::unique_ptr<base::DictionaryValue> meta);
+  void SetRecordsToResendMeta(const base::DictionaryValue& records_meta);
 
   void Clear();
 
@@ -0,0 +1,138 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_sync/records_to_resend_queue.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/values.h"
+#include "brave/components/brave_sync/brave_sync_prefs.h"
+#include "brave/components/brave_sync/jslib_messages.h"
+
+namespace brave_sync {
+
+namespace {
+
+const char kSendRetryNumber[] = "send_retry_number";
+const char kSyncTimestamp[] = "sync_timestamp";
+
+base::Value EntryToValue(int retry_number, base::Time sync_timestamp) {
+  base::Value meta(base::Value::Type::DICTIONARY);
+  meta.SetIntKey(kSendRetryNumber, retry_number);
+  meta.SetDoubleKey(kSyncTimestamp, sync_timestamp.ToJsTime());
+  return meta;
+}
+
+}  // namespace
+
+RecordsToResendQueue::RecordsToResendQueue(prefs::Prefs* prefs,
+                                           int max_retries,
+                                           GetWaitFunction get_wait)
+    : prefs_(prefs), max_retries_(max_retries), get_wait_(get_wait) {
+  DCHECK(prefs_);
+  DCHECK(get_wait_);
+}
+
+RecordsToResendQueue::~RecordsToResendQueue() = default;
+
+void RecordsToResendQueue::Add(const RecordsList& records) {
+  LoadIfNeeded();
+  base::DictionaryValue records_meta;
+  for (const auto& record : records) {
+    const Entry entry = {0, record->syncTimestamp};
+    Insert(record->objectId, entry);
+    records_meta.SetKey(record->objectId,
+                        EntryToValue(entry.retry_number,
+                                     entry.sync_timestamp));
+  }
+  if (!records_meta.empty())
+    prefs_->AddToRecordsToResend(records_meta);
+}
+
+void RecordsToResendQueue::Remove(const std::string& object_id) {
+  LoadIfNeeded();
+  if (entries_.find(object_id) == entries_.end())
+    return;
+  Erase(object_id);
+  prefs_->RemoveFromRecordsToResend(object_id);
+}
+
+std::vector<std::string> RecordsToResendQueue::TakeDue(base::Time now) {
+  LoadIfNeeded();
+  std::vector<std::string> due;
+  while (!queue_.empty() && queue_.begin()->first <= now) {
+    due.push_back(queue_.begin()->second);
+    queue_.erase(queue_.begin());
+  }
+
+  base::DictionaryValue records_meta;
+  for (const auto& object_id : due) {
+    Entry& entry = entries_[object_id];
+    entry.retry_number = std::min(entry.retry_number + 1, max_retries_);
+    entry.sync_timestamp = now;
+    queue_.emplace(GetDueTime(entry), object_id);
+    records_meta.SetKey(object_id,
+                        EntryToValue(entry.retry_number,
+                                     entry.sync_timestamp));
+  }
+  if (!records_meta.empty())
+    prefs_->SetRecordsToResendMeta(records_meta);
+  return due;
+}
+
+void RecordsToResendQueue::Reset() {
+  loaded_ = false;
+  entries_.clear();
+  queue_.clear();
+}
+
+size_t RecordsToResendQueue::size() {
+  LoadIfNeeded();
+  return entries_.size();
+}
+
+void RecordsToResendQueue::LoadIfNeeded() {
+  if (loaded_)
+    return;
+  loaded_ = true;
+  for (const auto& object_id : prefs_->GetRecordsToResend()) {
+    // Records without meta are resent right away.
+    Entry entry = {max_retries_, base::Time()};
+    const base::DictionaryValue* meta =
+        prefs_->GetRecordToResendMeta(object_id);
+    DCHECK(meta);
+    if (meta) {
+      meta->GetInteger(kSendRetryNumber, &entry.retry_number);
+      double sync_timestamp = 0;
+      meta->GetDouble(kSyncTimestamp, &sync_timestamp);
+      entry.sync_timestamp = base::Time::FromJsTime(sync_timestamp);
+    }
+    DCHECK_GE(entry.retry_number, 0);
+    entry.retry_number = std::min(entry.retry_number, max_retries_);
+    Insert(object_id, entry);
+  }
+}
+
+void RecordsToResendQueue::Insert(const std::string& object_id,
+                                  const Entry& entry) {
+  Erase(object_id);
+  entries_[object_id] = entry;
+  queue_.emplace(GetDueTime(entry), object_id);
+}
+
+void RecordsToResendQueue::Erase(const std::string& object_id) {
+  auto it = entries_.find(object_id);
+  if (it == entries_.end())
+    return;
+  queue_.erase(std::make_pair(GetDueTime(it->second), object_id));
+  entries_.erase(it);
+}
+
+base::Time RecordsToResendQueue::GetDueTime(const Entry& entry) const {
+  return entry.sync_timestamp + get_wait_(entry.retry_number);
+}
+
+}  // namespace brave_sync
@@ -0,0 +1,77 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SYNC_RECORDS_TO_RESEND_QUEUE_H_
+#define BRAVE_COMPONENTS_BRAVE_SYNC_RECORDS_TO_RESEND_QUEUE_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "brave/components/brave_sync/jslib_messages_fwd.h"
+
+namespace brave_sync {
+
+namespace prefs {
+class Prefs;
+}  // namespace prefs
+
+// Object ids of sent records which are not confirmed yet, ordered by the time
+// they are due to be sent again. Backed by the kSyncRecordsToResend prefs,
+// which are read once and then updated in one batch per operation.
+class RecordsToResendQueue {
+ public:
+  // Returns how long to wait before sending again a record which was already
+  // sent again |retry_number| times.
+  using GetWaitFunction = base::TimeDelta (*)(int retry_number);
+
+  RecordsToResendQueue(prefs::Prefs* prefs,
+                       int max_retries,
+                       GetWaitFunction get_wait);
+  ~RecordsToResendQueue();
+
+  // Queues |records| which were just sent.
+  void Add(const RecordsList& records);
+  // Drops |object_id| once its record has been confirmed.
+  void Remove(const std::string& object_id);
+  // Returns the object ids due to be sent again at |now| and schedules their
+  // next retry.
+  std::vector<std::string> TakeDue(base::Time now);
+
+  // Forgets the loaded state, must be called when the prefs were cleared.
+  void Reset();
+
+  size_t size();
+
+ private:
+  struct Entry {
+    int retry_number;
+    base::Time sync_timestamp;
+  };
+
+  void LoadIfNeeded();
+  void Insert(const std::string& object_id, const Entry& entry);
+  void Erase(const std::string& object_id);
+  base::Time GetDueTime(const Entry& entry) const;
+
+  prefs::Prefs* prefs_;  // Not owned
+  const int max_retries_;
+  const GetWaitFunction get_wait_;
+
+  bool loaded_ = false;
+  std::map<std::string, Entry> entries_;
+  // (due time, object_id), earliest first.
+  std::set<std::pair<base::Time, std::string>> queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordsToResendQueue);
+};
+
+}  // namespace brave_sync
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SYNC_RECORDS_TO_RESEND_QUEUE_H_
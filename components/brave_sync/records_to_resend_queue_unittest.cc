@@ -0,0 +1,122 @@
+/* Copyright 2019 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "brave/components/brave_sync/brave_sync_prefs.h"
+#include "brave/components/brave_sync/jslib_messages.h"
+#include "brave/components/brave_sync/records_to_resend_queue.h"
+#include "components/sync_preferences/testing_pref_service_syncable.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_sync {
+
+namespace {
+
+const int kMaxRetries = 2;
+// Whole milliseconds, so the time survives a round trip through prefs.
+const double kStartTime = 1573000000000;
+
+// 10, 20, 30 minutes.
+base::TimeDelta GetWait(int retry_number) {
+  return base::TimeDelta::FromMinutes(10 * (retry_number + 1));
+}
+
+RecordsList CreateRecords(const std::vector<std::string>& object_ids,
+                          base::Time sync_timestamp) {
+  RecordsList records;
+  for (const auto& object_id : object_ids) {
+    auto record = std::make_unique<jslib::SyncRecord>();
+    record->objectId = object_id;
+    record->syncTimestamp = sync_timestamp;
+    records.push_back(std::move(record));
+  }
+  return records;
+}
+
+}  // namespace
+
+class RecordsToResendQueueTest : public testing::Test {
+ public:
+  RecordsToResendQueueTest() {
+    prefs::Prefs::RegisterProfilePrefs(pref_service_.registry());
+    brave_sync_prefs_ = std::make_unique<prefs::Prefs>(&pref_service_);
+    queue_ = std::make_unique<RecordsToResendQueue>(brave_sync_prefs_.get(),
+                                                    kMaxRetries, &GetWait);
+  }
+
+ protected:
+  int GetRetryNumber(const std::string& object_id) {
+    int retry_number = -1;
+    const base::DictionaryValue* meta =
+        brave_sync_prefs_->GetRecordToResendMeta(object_id);
+    if (meta)
+      meta->GetInteger("send_retry_number", &retry_number);
+    return retry_number;
+  }
+
+  sync_preferences::TestingPrefServiceSyncable pref_service_;
+  std::unique_ptr<prefs::Prefs> brave_sync_prefs_;
+  std::unique_ptr<RecordsToResendQueue> queue_;
+};
+
+TEST_F(RecordsToResendQueueTest, TakesOnlyDueRecords) {
+  const base::Time start = base::Time::FromJsTime(kStartTime);
+  queue_->Add(CreateRecords({"a", "b"}, start));
+  queue_->Add(CreateRecords({"c"}, start + base::TimeDelta::FromMinutes(5)));
+  EXPECT_EQ(queue_->size(), 3u);
+  EXPECT_EQ(brave_sync_prefs_->GetRecordsToResend().size(), 3u);
+  EXPECT_EQ(GetRetryNumber("a"), 0);
+
+  EXPECT_TRUE(queue_->TakeDue(start).empty());
+  const base::Time first_retry = start + base::TimeDelta::FromMinutes(10);
+  EXPECT_THAT(queue_->TakeDue(first_retry), testing::ElementsAre("a", "b"));
+  EXPECT_EQ(GetRetryNumber("a"), 1);
+  EXPECT_EQ(GetRetryNumber("c"), 0);
+
+  EXPECT_THAT(queue_->TakeDue(start + base::TimeDelta::FromMinutes(15)),
+              testing::ElementsAre("c"));
+  // Second retry waits 20 minutes, the retry number stops at the maximum.
+  EXPECT_TRUE(
+      queue_->TakeDue(first_retry + base::TimeDelta::FromMinutes(19)).empty());
+  const base::Time second_retry =
+      first_retry + base::TimeDelta::FromMinutes(20);
+  EXPECT_THAT(queue_->TakeDue(second_retry), testing::ElementsAre("a", "b"));
+  EXPECT_THAT(queue_->TakeDue(second_retry + base::TimeDelta::FromMinutes(30)),
+              testing::UnorderedElementsAre("a", "b", "c"));
+  EXPECT_EQ(GetRetryNumber("a"), kMaxRetries);
+}
+
+TEST_F(RecordsToResendQueueTest, RemoveAndReload) {
+  const base::Time start = base::Time::FromJsTime(kStartTime);
+  queue_->Add(CreateRecords({"a", "b"}, start));
+  queue_->Remove("a");
+  queue_->Remove("unknown");
+  EXPECT_EQ(queue_->size(), 1u);
+  EXPECT_EQ(brave_sync_prefs_->GetRecordsToResend(),
+            std::vector<std::string>({"b"}));
+  EXPECT_EQ(brave_sync_prefs_->GetRecordToResendMeta("a"), nullptr);
+
+  // Re-adding a queued record restarts its wait without duplicating it.
+  queue_->Add(CreateRecords({"b"}, start + base::TimeDelta::FromMinutes(5)));
+  EXPECT_EQ(brave_sync_prefs_->GetRecordsToResend().size(), 1u);
+
+  // A new queue picks the state up from prefs.
+  RecordsToResendQueue loaded(brave_sync_prefs_.get(), kMaxRetries, &GetWait);
+  EXPECT_EQ(loaded.size(), 1u);
+  EXPECT_TRUE(loaded.TakeDue(start + base::TimeDelta::FromMinutes(10)).empty());
+  EXPECT_THAT(loaded.TakeDue(start + base::TimeDelta::FromMinutes(15)),
+              testing::ElementsAre("b"));
+
+  brave_sync_prefs_->Clear();
+  queue_->Reset();
+  EXPECT_EQ(queue_->size(), 0u);
+}
+
+}  // namespace brave_sync
@@ -5,6 +5,10 @@
 
 #include "brave/components/brave_sync/syncer_helper.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 #include "base/strings/string_number_conversions.h"
 #include "brave/components/brave_sync/bookmark_order_util.h"
 #include "brave/components/brave_sync/tools.h"
@@ -13,19 +17,16 @@
 namespace brave_sync {
 namespace {
 
-void SetOrder(bookmarks::BookmarkModel* model,
-              const bookmarks::BookmarkNode* node,
-              const std::string& parent_order) {
+std::string GetOrderForNode(const bookmarks::BookmarkNode* node,
+                            const std::string& parent_order) {
   DCHECK(!parent_order.empty());
   int index = node->parent()->GetIndexOf(node);
 
-  bookmarks::BookmarkNode* parent =
-      const_cast<bookmarks::BookmarkNode*>(node->parent());
-
-  auto* prev_node = index == 0 ? nullptr : parent->children()[index - 1].get();
-  auto* next_node = static_cast<size_t>(index) == parent->children().size() - 1
+  const auto& siblings = node->parent()->children();
+  auto* prev_node = index == 0 ? nullptr : siblings[index - 1].get();
+  auto* next_node = static_cast<size_t>(index) == siblings.size() - 1
                         ? nullptr
-                        : parent->children()[index + 1].get();
+                        : siblings[index + 1].get();
 
   std::string prev_order;
   std::string next_order;
@@ -35,9 +36,7 @@ void SetOrder(bookmarks::BookmarkModel* model,
   if (next_node)
     next_node->GetMetaInfo("order", &next_order);
 
-  std::string order =
-      brave_sync::GetOrder(prev_order, next_order, parent_order);
-  model->SetNodeMetaInfo(node, "order", order);
+  return brave_sync::GetOrder(prev_order, next_order, parent_order);
 }
 
 size_t GetIndexByOrder(const std::string& record_order) {
@@ -60,71 +59,108 @@ size_t GetIndexByCompareOrderStartFrom(const bookmarks::BookmarkNode* parent,
   std::string src_order;
   src->GetMetaInfo("order", &src_order);
   DCHECK(!src_order.empty());
-  bool use_order = true;  // If false use object_id
   std::string src_object_id;
-  while (index < parent->children().size()) {
-    const bookmarks::BookmarkNode* node = parent->children()[index].get();
-    if (src->id() == node->id()) {
-      // We reached ourselves, no sense to go further, because we know all
-      // unsorted elements are in the end
-      return index;
-    }
 
-    if (use_order) {
-      std::string node_order;
-      node->GetMetaInfo("order", &node_order);
-      if (!node_order.empty() &&
-          brave_sync::CompareOrder(src_order, node_order)) {
-        return index;
-      }
-
-      if (src_order == node_order) {
-        use_order = false;
-      }
-    }
-
-    if (!use_order) {
-      if (src_object_id.empty()) {
+  // |src| goes before |node| when its order is lower, nodes with the same
+  // order are sorted by object_id.
+  auto goes_before = [&](const std::unique_ptr<bookmarks::BookmarkNode>& node) {
+    std::string node_order;
+    node->GetMetaInfo("order", &node_order);
+    if (node_order.empty())
+      return false;
+    if (src_order == node_order) {
+      if (src_object_id.empty())
         src->GetMetaInfo("object_id", &src_object_id);
-      }
-
       std::string node_object_id;
       node->GetMetaInfo("object_id", &node_object_id);
-
-      if (src_object_id < node_object_id) {
-        return index;
-      }
+      return src_object_id < node_object_id;
     }
-    ++index;
+    return brave_sync::CompareOrder(src_order, node_order);
+  };
+
+  // Children before |src| are already sorted, unsorted elements are in the
+  // end. So we only need to search up to ourselves, and can do it with a
+  // binary search instead of parsing the order of every sibling.
+  const auto& children = parent->children();
+  auto begin = children.begin() + std::min(index, children.size());
+  auto end = std::find_if(
+      begin, children.end(),
+      [src](const std::unique_ptr<bookmarks::BookmarkNode>& node) {
+        return node.get() == src;
+      });
+  auto it = std::partition_point(
+      begin, end,
+      [&](const std::unique_ptr<bookmarks::BookmarkNode>& node) {
+        return !goes_before(node);
+      });
+  return it - children.begin();
+}
+
+std::vector<const bookmarks::BookmarkNode*> GetChildrenSortedByOrder(
+    const bookmarks::BookmarkNode* parent) {
+  DCHECK(parent);
+  struct OrderedChild {
+    std::string order;
+    std::string object_id;
+    const bookmarks::BookmarkNode* node;
+  };
+  std::vector<const bookmarks::BookmarkNode*> sorted;
+  std::vector<size_t> ordered_slots;
+  std::vector<OrderedChild> ordered;
+  for (const auto& child : parent->children()) {
+    sorted.push_back(child.get());
+    OrderedChild ordered_child;
+    if (!child->GetMetaInfo("order", &ordered_child.order))
+      continue;
+    child->GetMetaInfo("object_id", &ordered_child.object_id);
+    ordered_child.node = child.get();
+    ordered_slots.push_back(sorted.size() - 1);
+    ordered.push_back(std::move(ordered_child));
   }
-  return index;
+
+  // Read the meta info once and sort, rather than searching for the position
+  // of every child separately. Nodes with the same order are sorted by
+  // object_id, as in GetIndexByCompareOrderStartFrom.
+  std::stable_sort(ordered.begin(), ordered.end(),
+                   [](const OrderedChild& lhs, const OrderedChild& rhs) {
+                     if (lhs.order == rhs.order)
+                       return lhs.object_id < rhs.object_id;
+                     return brave_sync::CompareOrder(lhs.order, rhs.order);
+                   });
+  for (size_t i = 0; i < ordered.size(); ++i)
+    sorted[ordered_slots[i]] = ordered[i].node;
+  return sorted;
 }
 
 void AddBraveMetaInfo(const bookmarks::BookmarkNode* node,
                       bookmarks::BookmarkModel* model) {
+  // Collect the changes and write them with a single SetNodeMetaInfoMap, so
+  // observers are notified and the store is scheduled to save only once.
+  bookmarks::BookmarkNode::MetaInfoMap meta_info;
+  if (node->GetMetaInfoMap())
+    meta_info = *node->GetMetaInfoMap();
+
   std::string parent_order;
   node->parent()->GetMetaInfo("order", &parent_order);
-  SetOrder(model, node, parent_order);
+  meta_info["order"] = GetOrderForNode(node, parent_order);
 
-  std::string object_id;
-  node->GetMetaInfo("object_id", &object_id);
+  std::string& object_id = meta_info["object_id"];
   // newly created node
   if (object_id.empty()) {
     object_id = tools::GenerateObjectId();
   }
-  model->SetNodeMetaInfo(node, "object_id", object_id);
 
   std::string parent_object_id;
   node->parent()->GetMetaInfo("object_id", &parent_object_id);
-  model->SetNodeMetaInfo(node, "parent_object_id", parent_object_id);
+  meta_info["parent_object_id"] = parent_object_id;
 
-  std::string sync_timestamp;
-  node->GetMetaInfo("sync_timestamp", &sync_timestamp);
+  std::string& sync_timestamp = meta_info["sync_timestamp"];
   if (sync_timestamp.empty()) {
     sync_timestamp = std::to_string(base::Time::Now().ToJsTime());
-    model->SetNodeMetaInfo(node, "sync_timestamp", sync_timestamp);
   }
   DCHECK(!sync_timestamp.empty());
+
+  model->SetNodeMetaInfoMap(node, meta_info);
 }
 
 size_t GetIndex(const bookmarks::BookmarkNode* parent,
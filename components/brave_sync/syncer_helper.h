@@ -8,6 +8,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace bookmarks {
 class BookmarkModel;
@@ -27,6 +28,11 @@ size_t GetIndexByCompareOrderStartFrom(const bookmarks::BookmarkNode* parent,
                                        const bookmarks::BookmarkNode* src,
                                        size_t index);
 
+// Returns the children of |parent| in the positions their "order" meta info
+// puts them in. Children without an order keep their current slot.
+std::vector<const bookmarks::BookmarkNode*> GetChildrenSortedByOrder(
+    const bookmarks::BookmarkNode* parent);
+
 }  // namespace brave_sync
 
 #endif  // BRAVE_COMPONENTS_BRAVE_SYNC_SYNCER_HELPER_H_
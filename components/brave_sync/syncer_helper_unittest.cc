@@ -334,6 +334,81 @@ TEST_F(SyncerHelperTest, GetIndexInFolder) {
   EXPECT_EQ(GetIndex(folder1, &node), 1u);
 }
 
+TEST_F(SyncerHelperTest, GetIndexByCompareOrderStartFromManyChildren) {
+  for (int i = 0; i < 100; ++i) {
+    const auto* node_a =
+        model()->AddURL(model()->bookmark_bar_node(), i,
+                        base::ASCIIToUTF16("a.com"), GURL("https://a.com/"));
+    std::string order = "1.0.1." + base::NumberToString(2 * (i + 1));
+    model()->SetNodeMetaInfo(node_a, "order", order);
+  }
+
+  // Node which is not a child yet can go anywhere.
+  BookmarkNode node(/*id=*/100, base::GenerateGUID(), GURL("https://b.com"));
+  node.SetMetaInfo("order", "1.0.1.1");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(), &node,
+                                            0),
+            0u);
+  node.SetMetaInfo("order", "1.0.1.51");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(), &node,
+                                            0),
+            25u);
+  node.SetMetaInfo("order", "1.0.1.50.1");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(), &node,
+                                            0),
+            25u);
+  node.SetMetaInfo("order", "1.0.1.201");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(), &node,
+                                            0),
+            100u);
+  // Search respects the start index.
+  node.SetMetaInfo("order", "1.0.1.1");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(), &node,
+                                            30),
+            30u);
+
+  // Appended child is placed among its sorted siblings.
+  const auto* node_c =
+      model()->AddURL(model()->bookmark_bar_node(), 100,
+                      base::ASCIIToUTF16("c.com"), GURL("https://c.com/"));
+  model()->SetNodeMetaInfo(node_c, "order", "1.0.1.99");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(),
+                                            node_c, 0),
+            49u);
+  model()->SetNodeMetaInfo(node_c, "order", "1.0.1.300");
+  EXPECT_EQ(GetIndexByCompareOrderStartFrom(model()->bookmark_bar_node(),
+                                            node_c, 0),
+            100u);
+}
+
+TEST_F(SyncerHelperTest, GetChildrenSortedByOrder) {
+  const BookmarkNode* parent = model()->bookmark_bar_node();
+  const auto* node_a = model()->AddURL(parent, 0, base::ASCIIToUTF16("a.com"),
+                                       GURL("https://a.com/"));
+  model()->SetNodeMetaInfo(node_a, "order", "1.0.1.10");
+  const auto* node_b = model()->AddURL(parent, 1, base::ASCIIToUTF16("b.com"),
+                                       GURL("https://b.com/"));
+  model()->SetNodeMetaInfo(node_b, "order", "1.0.1.2");
+  // Node without an order keeps its slot.
+  const auto* node_c = model()->AddURL(parent, 2, base::ASCIIToUTF16("c.com"),
+                                       GURL("https://c.com/"));
+  const auto* node_d = model()->AddURL(parent, 3, base::ASCIIToUTF16("d.com"),
+                                       GURL("https://d.com/"));
+  model()->SetNodeMetaInfo(node_d, "order", "1.0.1.2");
+  model()->SetNodeMetaInfo(node_d, "object_id", "...");
+  model()->SetNodeMetaInfo(node_b, "object_id", "@@@");
+  const auto* node_e = model()->AddURL(parent, 4, base::ASCIIToUTF16("e.com"),
+                                       GURL("https://e.com/"));
+  model()->SetNodeMetaInfo(node_e, "order", "1.0.1.1.5");
+
+  EXPECT_THAT(GetChildrenSortedByOrder(parent),
+              testing::ElementsAre(node_e, node_d, node_c, node_b, node_a));
+  // Sorting does not touch the model.
+  EXPECT_EQ(parent->children()[0].get(), node_a);
+
+  EXPECT_TRUE(GetChildrenSortedByOrder(model()->other_node()).empty());
+}
+
 TEST_F(SyncerHelperTest, SameOrderBookmarksSordetByObjectIdFull3) {
   // This test emulates folowing STR
   // 1. on device A create bookmarks A1.com and A2.com
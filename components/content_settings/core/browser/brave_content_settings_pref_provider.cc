@@ -5,10 +5,12 @@
 
 #include "brave/components/content_settings/core/browser/brave_content_settings_pref_provider.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 
 #include "base/bind.h"
+#include "base/no_destructor.h"
 #include "base/task/post_task.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "components/content_settings/core/browser/content_settings_pref.h"
@@ -21,10 +23,15 @@ namespace content_settings {
 
 namespace {
 
+const ContentSettingsPattern& GetFirstPartyPattern() {
+  static const base::NoDestructor<ContentSettingsPattern> first_party_pattern(
+      ContentSettingsPattern::FromString("https://firstParty/*"));
+  return *first_party_pattern;
+}
+
 Rule CloneRule(const Rule& rule, bool reverse_patterns = false) {
   auto secondary_pattern = rule.secondary_pattern;
-  if (secondary_pattern ==
-      ContentSettingsPattern::FromString("https://firstParty/*")) {
+  if (secondary_pattern == GetFirstPartyPattern()) {
     secondary_pattern = rule.primary_pattern;
   }
 
@@ -62,18 +69,32 @@ class BraveShieldsRuleIterator : public RuleIterator {
 };
 
 
+// Shield rules in precedence order, plus the setting of each primary pattern
+// so that the common case of a cookie rule with a shield rule for the same
+// pattern doesn't need a scan.
+struct ShieldRules {
+  std::vector<Rule> rules;
+  std::map<ContentSettingsPattern, ContentSetting> by_primary_pattern;
+};
+
 bool IsActive(const Rule& cookie_rule,
-              const std::vector<Rule>& shield_rules) {
+              const ShieldRules& shield_rules) {
   // don't include default rules in the iterator
   if (cookie_rule.primary_pattern == ContentSettingsPattern::Wildcard() &&
       (cookie_rule.secondary_pattern == ContentSettingsPattern::Wildcard() ||
-       cookie_rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://firstParty/*"))) {
+       cookie_rule.secondary_pattern == GetFirstPartyPattern())) {
     return false;
   }
 
+  // The rules are sorted by precedence, so an identical pattern comes before
+  // any less specific (SUCCESSOR) pattern and is the one the scan would find.
+  auto identity =
+      shield_rules.by_primary_pattern.find(cookie_rule.primary_pattern);
+  if (identity != shield_rules.by_primary_pattern.end())
+    return identity->second != CONTENT_SETTING_BLOCK;
+
   bool default_value = true;
-  for (const auto& shield_rule : shield_rules) {
+  for (const auto& shield_rule : shield_rules.rules) {
     auto primary_compare =
         shield_rule.primary_pattern.Compare(cookie_rule.primary_pattern);
     // TODO(bridiver) - verify that SUCCESSOR is correct and not PREDECESSOR
@@ -141,16 +162,11 @@ bool BravePrefProvider::SetWebsiteSetting(
 
   // handle changes to brave cookie settings from chromium cookie settings UI
   if (content_type == CONTENT_SETTINGS_TYPE_COOKIES) {
-    auto* value = in_value.get();
-    auto match = std::find_if(
-        brave_cookie_rules_[off_the_record_].begin(),
-        brave_cookie_rules_[off_the_record_].end(),
-        [primary_pattern, secondary_pattern, value](const auto& rule) {
-          return rule.primary_pattern == primary_pattern &&
-                 rule.secondary_pattern == secondary_pattern &&
-                 ValueToContentSetting(&rule.value) !=
-                    ValueToContentSetting(value); });
-    if (match != brave_cookie_rules_[off_the_record_].end()) {
+    const auto& brave_cookie_rules = brave_cookie_rules_[off_the_record_];
+    auto match = brave_cookie_rules.find(
+        PatternPair(primary_pattern, secondary_pattern));
+    if (match != brave_cookie_rules.end() &&
+        match->second != ValueToContentSetting(in_value.get())) {
       // swap primary/secondary pattern - see CloneRule
       auto plugin_primary_pattern = secondary_pattern;
       auto plugin_secondary_pattern = primary_pattern;
@@ -158,7 +174,7 @@ bool BravePrefProvider::SetWebsiteSetting(
       // convert to legacy firstParty format for brave plugin settings
       if (plugin_primary_pattern == plugin_secondary_pattern) {
         plugin_secondary_pattern =
-            ContentSettingsPattern::FromString("https://firstParty/*");
+            GetFirstPartyPattern();
       }
 
       // change to type PLUGINS
@@ -211,9 +227,13 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
       incognito);
 
   // collect shield rules
-  std::vector<Rule> shield_rules;
+  ShieldRules shield_rules;
   while (brave_shields_iterator && brave_shields_iterator->HasNext()) {
-    shield_rules.push_back(CloneRule(brave_shields_iterator->Next()));
+    shield_rules.rules.push_back(CloneRule(brave_shields_iterator->Next()));
+    const Rule& shield_rule = shield_rules.rules.back();
+    // Keep the first rule of each pattern, the one a scan would find.
+    shield_rules.by_primary_pattern.emplace(
+        shield_rule.primary_pattern, ValueToContentSetting(&shield_rule.value));
   }
 
   brave_shields_iterator.reset();
@@ -225,18 +245,23 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
       incognito);
 
   auto old_rules = std::move(brave_cookie_rules_[incognito]);
+  auto& new_rules = brave_cookie_rules_[incognito];
+  new_rules.clear();
 
   // Matching cookie rules against shield rules.
   while (brave_cookies_iterator && brave_cookies_iterator->HasNext()) {
     auto rule = brave_cookies_iterator->Next();
     if (IsActive(rule, shield_rules)) {
       rules.push_back(CloneRule(rule, true));
-      brave_cookie_rules_[incognito].push_back(CloneRule(rule, true));
+      const Rule& cookie_rule = rules.back();
+      new_rules[PatternPair(cookie_rule.primary_pattern,
+                            cookie_rule.secondary_pattern)] =
+          ValueToContentSetting(&cookie_rule.value);
     }
   }
 
   // Adding shields down rules (they always override cookie rules).
-  for (const auto& shield_rule : shield_rules) {
+  for (const auto& shield_rule : shield_rules.rules) {
     // There is no global shields rule
     if (shield_rule.primary_pattern.MatchesAllHosts())
       NOTREACHED();
@@ -247,48 +272,32 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
           Rule(ContentSettingsPattern::Wildcard(),
                shield_rule.primary_pattern,
                ContentSettingToValue(CONTENT_SETTING_ALLOW)->Clone()));
-      brave_cookie_rules_[incognito].push_back(
-          Rule(ContentSettingsPattern::Wildcard(),
-               shield_rule.primary_pattern,
-               ContentSettingToValue(CONTENT_SETTING_ALLOW)->Clone()));
-    }
-  }
-
-  // get the list of changes
-  std::vector<Rule> brave_cookie_updates;
-  for (const auto& new_rule : brave_cookie_rules_[incognito]) {
-    auto match = std::find_if(
-        old_rules.begin(),
-        old_rules.end(),
-        [&new_rule](const auto& old_rule) {
-          // we want an exact match here because any change to the rule
-          // is an update
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern &&
-                 ValueToContentSetting(&new_rule.value) ==
-                    ValueToContentSetting(&old_rule.value);
-        });
-    if (match == old_rules.end()) {
-      brave_cookie_updates.push_back(CloneRule(new_rule));
+      new_rules[PatternPair(ContentSettingsPattern::Wildcard(),
+                            shield_rule.primary_pattern)] =
+          CONTENT_SETTING_ALLOW;
     }
   }
 
-  // find any removed rules
-  for (const auto& old_rule : old_rules) {
-    auto match = std::find_if(
-        brave_cookie_rules_[incognito].begin(),
-        brave_cookie_rules_[incognito].end(),
-        [&old_rule](const auto& new_rule) {
-          // we only care about the patterns here because we're looking
-          // for deleted rules, not changed rules
-          return new_rule.primary_pattern == old_rule.primary_pattern &&
-                 new_rule.secondary_pattern == old_rule.secondary_pattern;
-        });
-    if (match == brave_cookie_rules_[incognito].end()) {
-      brave_cookie_updates.push_back(
-          Rule(old_rule.primary_pattern,
-               old_rule.secondary_pattern,
-               base::Value()));
+  // get the list of changes: both maps are sorted by patterns, so one merge
+  // pass finds the added, changed and removed rules.
+  std::vector<PatternPair> brave_cookie_updates;
+  auto old_rule = old_rules.begin();
+  auto new_rule = new_rules.begin();
+  while (old_rule != old_rules.end() || new_rule != new_rules.end()) {
+    if (new_rule == new_rules.end() ||
+        (old_rule != old_rules.end() && old_rule->first < new_rule->first)) {
+      // removed
+      brave_cookie_updates.push_back((old_rule++)->first);
+    } else if (old_rule == old_rules.end() ||
+               new_rule->first < old_rule->first) {
+      // added
+      brave_cookie_updates.push_back((new_rule++)->first);
+    } else {
+      // any change to the setting is an update
+      if (old_rule->second != new_rule->second)
+        brave_cookie_updates.push_back(new_rule->first);
+      ++old_rule;
+      ++new_rule;
     }
   }
 
@@ -305,11 +314,12 @@ void BravePrefProvider::UpdateCookieRules(ContentSettingsType content_type,
   }
 }
 
-void BravePrefProvider::NotifyChanges(const std::vector<Rule>& rules,
-                                      bool incognito) {
-  for (const auto& rule : rules) {
-    Notify(rule.primary_pattern,
-           rule.secondary_pattern,
+void BravePrefProvider::NotifyChanges(
+    const std::vector<PatternPair>& patterns,
+    bool incognito) {
+  for (const auto& pattern : patterns) {
+    Notify(pattern.first,
+           pattern.second,
            CONTENT_SETTINGS_TYPE_COOKIES,
            "");
   }
@@ -14,6 +14,7 @@
 #include "base/memory/weak_ptr.h"
 #include "components/content_settings/core/browser/content_settings_observer.h"
 #include "components/content_settings/core/browser/content_settings_pref_provider.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
 #include "components/prefs/pref_change_registrar.h"
 
 namespace content_settings {
@@ -49,7 +50,7 @@ class BravePrefProvider : public PrefProvider,
  private:
   void UpdateCookieRules(ContentSettingsType content_type, bool incognito);
   void OnCookieSettingsChanged(ContentSettingsType content_type);
-  void NotifyChanges(const std::vector<Rule>& rules, bool incognito);
+  void NotifyChanges(const std::vector<PatternPair>& patterns, bool incognito);
 
   // content_settings::Observer overrides:
   void OnContentSettingChanged(const ContentSettingsPattern& primary_pattern,
@@ -61,7 +62,10 @@ class BravePrefProvider : public PrefProvider,
   PrefChangeRegistrar brave_pref_change_registrar_;
 
   std::map<bool /* is_incognito */, std::vector<Rule>> cookie_rules_;
-  std::map<bool /* is_incognito */, std::vector<Rule>> brave_cookie_rules_;
+  // Brave cookie rules merged into |cookie_rules_|, keyed by their patterns so
+  // that changes can be diffed and looked up without scanning.
+  std::map<bool /* is_incognito */, std::map<PatternPair, ContentSetting>>
+      brave_cookie_rules_;
 
   base::WeakPtrFactory<BravePrefProvider> weak_factory_;
 
@@ -38,6 +38,16 @@ const char kScripts[] = "scripts";
 const char kRewards[] = "rewards-enabled";
 const char kTwitterTips[] = "twitter-tips-enabled";
 
+namespace {
+
+bool IsFeatureEnabled(const GreaselionFeatures& state,
+                      GreaselionFeature feature) {
+  auto it = state.find(feature);
+  return it != state.end() && it->second;
+}
+
+}  // namespace
+
 GreaselionPreconditionValue GreaselionRule::ParsePrecondition(
     base::DictionaryValue* root,
     const char* key) {
@@ -100,19 +110,21 @@ bool GreaselionRule::PreconditionFulfilled(
   }
 }
 
-bool GreaselionRule::Matches(GreaselionFeatures state) const {
+bool GreaselionRule::Matches(const GreaselionFeatures& state) const {
   if (!PreconditionFulfilled(preconditions_.rewards_enabled,
-                             state[greaselion::REWARDS]))
+                             IsFeatureEnabled(state, greaselion::REWARDS)))
     return false;
   if (!PreconditionFulfilled(preconditions_.twitter_tips_enabled,
-                             state[greaselion::TWITTER_TIPS]))
+                             IsFeatureEnabled(state, greaselion::TWITTER_TIPS)))
     return false;
   return true;
 }
 
 GreaselionDownloadService::GreaselionDownloadService(
     LocalDataFilesService* local_data_files_service)
-    : LocalDataFilesObserver(local_data_files_service), weak_factory_(this) {
+    : LocalDataFilesObserver(local_data_files_service),
+      rules_version_(0),
+      weak_factory_(this) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -121,6 +133,7 @@ GreaselionDownloadService::~GreaselionDownloadService() {}
 void GreaselionDownloadService::OnDATFileDataReady(std::string contents) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   rules_.clear();
+  rules_version_++;
   if (contents.empty()) {
     LOG(ERROR) << "Could not obtain Greaselion configuration";
     return;
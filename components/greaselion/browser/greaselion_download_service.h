@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_DOWNLOAD_SERVICE_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -48,10 +50,12 @@ class GreaselionRule {
              const base::FilePath& root_dir);
   ~GreaselionRule();
 
-  bool Matches(GreaselionFeatures state) const;
+  bool Matches(const GreaselionFeatures& state) const;
   std::string name() const { return name_; }
-  std::vector<std::string> url_patterns() const { return url_patterns_; }
-  std::vector<base::FilePath> scripts() const { return scripts_; }
+  const std::vector<std::string>& url_patterns() const {
+    return url_patterns_;
+  }
+  const std::vector<base::FilePath>& scripts() const { return scripts_; }
 
  private:
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
@@ -78,6 +82,8 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
   ~GreaselionDownloadService() override;
 
   std::vector<std::unique_ptr<GreaselionRule>>* rules();
+  // Bumped every time the rules are reloaded.
+  uint64_t rules_version() const { return rules_version_; }
   scoped_refptr<base::SequencedTaskRunner> GetTaskRunner();
 
   // implementation of LocalDataFilesObserver
@@ -103,6 +109,7 @@ class GreaselionDownloadService : public LocalDataFilesObserver {
 
   base::ObserverList<Observer> observers_;
   std::vector<std::unique_ptr<GreaselionRule>> rules_;
+  uint64_t rules_version_;
   base::FilePath install_dir_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,11 +92,11 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   root->SetStringPath(extensions::manifest_keys::kPublicKey, key);
 
   auto js_files = std::make_unique<base::ListValue>();
-  for (auto script : rule->scripts())
+  for (const auto& script : rule->scripts())
     js_files->AppendString(script.BaseName().value());
 
   auto matches = std::make_unique<base::ListValue>();
-  for (auto url_pattern : rule->url_patterns())
+  for (const auto& url_pattern : rule->url_patterns())
     matches->AppendString(url_pattern);
 
   auto content_script = std::make_unique<base::DictionaryValue>();
@@ -125,7 +126,7 @@ scoped_refptr<Extension> ConvertGreaselionRuleToExtensionOnTaskRunner(
   }
 
   // Copy the script files to our extension directory.
-  for (auto script : rule->scripts()) {
+  for (const auto& script : rule->scripts()) {
     if (!base::CopyFile(script, temp_dir.GetPath().Append(script.BaseName()))) {
       LOG(ERROR) << "Could not copy Greaselion script";
       return NULL;
@@ -161,6 +162,8 @@ GreaselionServiceImpl::GreaselionServiceImpl(
       extension_registry_(extension_registry),
       all_rules_installed_successfully_(true),
       update_in_progress_(false),
+      update_pending_(false),
+      rules_version_(0),
       pending_installs_(0),
       task_runner_(std::move(task_runner)),
       weak_factory_(this) {
@@ -174,61 +177,83 @@ GreaselionServiceImpl::~GreaselionServiceImpl() {
 }
 
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
-  if (update_in_progress_)
+  // Every tab reports the same reload, only the first report needs an
+  // update, which converts every extension again.
+  if (download_service_->rules_version() == rules_version_)
     return;
-  update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
-    CreateAndInstallExtensions();
+  Update();
+}
+
+void GreaselionServiceImpl::Update() {
+  if (update_in_progress_) {
+    // Picked up by MaybeNotifyObservers() once the running update is done.
+    update_pending_ = true;
     return;
   }
+  update_in_progress_ = true;
+  update_pending_ = false;
+  const bool rules_changed =
+      download_service_->rules_version() != rules_version_;
+  rules_version_ = download_service_->rules_version();
+
+  std::set<std::string> matching_rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (rule->Matches(state_))
+      matching_rules.insert(rule->name());
+  }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
+  // Unload the extensions whose rule was reloaded or no longer matches. The
+  // extensions of rules which still match stay installed as they are.
+  std::vector<extensions::ExtensionId> stale_extensions;
+  for (const auto& extension : greaselion_extensions_) {
+    if (rules_changed || !matching_rules.count(extension.second))
+      stale_extensions.push_back(extension.first);
+  }
+  for (const auto& id : stale_extensions) {
+    // Erase first so OnExtensionUnloaded doesn't need to know about updates,
+    // and so extensions which were never loaded are forgotten as well.
+    greaselion_extensions_.erase(id);
     extension_service_->UnloadExtension(
         id, extensions::UnloadedExtensionReason::UPDATE);
   }
+
+  std::set<std::string> installed_rules;
+  for (const auto& extension : greaselion_extensions_)
+    installed_rules.insert(extension.second);
+  std::vector<GreaselionRule*> rules_to_install;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (matching_rules.count(rule->name()) &&
+        !installed_rules.count(rule->name()))
+      rules_to_install.push_back(rule.get());
+  }
+  CreateAndInstallExtensions(rules_to_install);
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+void GreaselionServiceImpl::CreateAndInstallExtensions(
+    const std::vector<GreaselionRule*>& rules) {
   DCHECK(update_in_progress_);
-  all_rules_installed_successfully_ = true;
-  pending_installs_ = 0;
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_)) {
-      pending_installs_ += 1;
-    }
-  }
+  pending_installs_ = static_cast<int>(rules.size());
   if (!pending_installs_) {
-    // no rules match, nothing else to do
+    // nothing to convert, the installed extensions are up to date
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_)) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule.get(), install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+  for (GreaselionRule* rule : rules) {
+    // Convert script file to component extension. This must run on extension
+    // file task runner, which was passed in in the constructor.
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner, rule,
+                       install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), rule->name()));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_name,
     scoped_refptr<extensions::Extension> extension) {
   if (!extension.get()) {
     all_rules_installed_successfully_ = false;
@@ -236,7 +261,7 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(extension->id());
+    greaselion_extensions_[extension->id()] = rule_name;
     extension_system_->ready().Post(
         FROM_HERE,
         base::BindOnce(&GreaselionServiceImpl::Install,
@@ -252,9 +277,7 @@ void GreaselionServiceImpl::Install(
 void GreaselionServiceImpl::OnExtensionReady(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
+  if (!greaselion_extensions_.count(extension->id())) {
     // not one of ours
     return;
   }
@@ -267,17 +290,9 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     content::BrowserContext* browser_context,
     const extensions::Extension* extension,
     extensions::UnloadedExtensionReason reason) {
-  auto index = std::find(greaselion_extensions_.begin(),
-                         greaselion_extensions_.end(), extension->id());
-  if (index == greaselion_extensions_.end()) {
-    // not one of ours
-    return;
-  }
-  greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
-    // It's time!
-    CreateAndInstallExtensions();
-  }
+  // Our own updates forget their extensions before unloading them, this only
+  // catches extensions unloaded by someone else.
+  greaselion_extensions_.erase(extension->id());
 }
 
 void GreaselionServiceImpl::AddObserver(Observer* observer) {
@@ -291,16 +306,26 @@ void GreaselionServiceImpl::RemoveObserver(Observer* observer) {
 void GreaselionServiceImpl::MaybeNotifyObservers() {
   if (!pending_installs_) {
     update_in_progress_ = false;
+    if (update_pending_) {
+      // Observers are notified once the pending update is done too.
+      Update();
+      return;
+    }
     for (Observer& observer : observers_)
       observer.OnExtensionsReady(this, all_rules_installed_successfully_);
+    // Chained updates report their failures together, the next one starts
+    // clean.
+    all_rules_installed_successfully_ = true;
   }
 }
 
 void GreaselionServiceImpl::SetFeatureEnabled(GreaselionFeature feature,
                                               bool enabled) {
   DCHECK(feature >= 0 && feature < LAST_FEATURE);
+  if (state_[feature] == enabled)
+    return;
   state_[feature] = enabled;
-  UpdateInstalledExtensions();
+  Update();
 }
 
 bool GreaselionServiceImpl::ready() {
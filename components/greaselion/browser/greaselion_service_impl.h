@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 #define BRAVE_COMPONENTS_GREASELION_BROWSER_GREASELION_SERVICE_IMPL_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <string>
 #include <vector>
@@ -31,6 +33,7 @@ class ExtensionSystem;
 namespace greaselion {
 
 class GreaselionDownloadService;
+class GreaselionRule;
 
 class GreaselionServiceImpl : public GreaselionService {
  public:
@@ -57,8 +60,13 @@ class GreaselionServiceImpl : public GreaselionService {
                            extensions::UnloadedExtensionReason reason) override;
 
  private:
-  void CreateAndInstallExtensions();
-  void PostConvert(scoped_refptr<extensions::Extension> extension);
+  // Brings the installed extensions in line with |state_|: unloads the
+  // extensions of rules which no longer match (all of them when the rules were
+  // reloaded) and converts only the rules which newly match.
+  void Update();
+  void CreateAndInstallExtensions(const std::vector<GreaselionRule*>& rules);
+  void PostConvert(const std::string& rule_name,
+                   scoped_refptr<extensions::Extension> extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
 
@@ -68,12 +76,18 @@ class GreaselionServiceImpl : public GreaselionService {
   extensions::ExtensionSystem* extension_system_;      // NOT OWNED
   extensions::ExtensionService* extension_service_;    // NOT OWNED
   extensions::ExtensionRegistry* extension_registry_;  // NOT OWNED
+  // Whether the updates since observers were last notified all succeeded.
   bool all_rules_installed_successfully_;
   bool update_in_progress_;
+  // Another update was requested while one was in progress.
+  bool update_pending_;
+  // Version of the download service rules the last update started from.
+  uint64_t rules_version_;
   int pending_installs_;
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<Observer> observers_;
-  std::vector<extensions::ExtensionId> greaselion_extensions_;
+  // Installed Greaselion extensions, mapped to the name of their rule.
+  std::map<extensions::ExtensionId, std::string> greaselion_extensions_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GreaselionServiceImpl);
@@ -9,7 +9,11 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/omnibox/browser/autocomplete_input.h"
@@ -35,16 +39,12 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
   const std::string input_text =
       base::ToLowerASCII(base::UTF16ToUTF8(input.text()));
 
-  for (std::vector<std::string>::const_iterator i = top_sites_.begin();
-       (i != top_sites_.end()) && (matches_.size() < provider_max_matches());
-       ++i) {
-    const std::string &current_site = *i;
-    size_t foundPos = current_site.find(input_text);
-    if (std::string::npos != foundPos) {
-      ACMatchClassifications styles =
-          StylesForSingleMatch(input_text, current_site, foundPos);
-      AddMatch(base::ASCIIToUTF16(current_site), styles);
-    }
+  for (const auto& site_match :
+       FindSites(input_text, provider_max_matches())) {
+    const std::string& current_site = top_sites_[site_match.first];
+    ACMatchClassifications styles =
+        StylesForSingleMatch(input_text, current_site, site_match.second);
+    AddMatch(base::ASCIIToUTF16(current_site), styles);
   }
 
   for (size_t i = 0; i < matches_.size(); ++i)
@@ -61,6 +61,90 @@ void TopSitesProvider::Start(const AutocompleteInput& input,
 
 TopSitesProvider::~TopSitesProvider() {}
 
+// static
+const std::vector<TopSitesProvider::SiteSuffix>&
+TopSitesProvider::GetSuffixIndex() {
+  static const base::NoDestructor<std::vector<SiteSuffix>> index([] {
+    std::vector<SiteSuffix> suffixes;
+    for (size_t site = 0; site < top_sites_.size(); ++site) {
+      for (size_t pos = 0; pos < top_sites_[site].length(); ++pos)
+        suffixes.emplace_back(site, pos);
+    }
+    std::sort(suffixes.begin(), suffixes.end(),
+              [](const SiteSuffix& a, const SiteSuffix& b) {
+                return base::StringPiece(top_sites_[a.first]).substr(a.second) <
+                       base::StringPiece(top_sites_[b.first]).substr(b.second);
+              });
+    return suffixes;
+  }());
+  return *index;
+}
+
+// static
+std::vector<std::pair<size_t, size_t>> TopSitesProvider::FindSites(
+    const std::string& input_text,
+    size_t max_matches) {
+  // All suffixes starting with |input_text| are adjacent in the index, so
+  // only the sites that actually match are visited.
+  const base::StringPiece input(input_text);
+  auto prefix = [&input](const SiteSuffix& suffix) {
+    return base::StringPiece(top_sites_[suffix.first])
+        .substr(suffix.second, input.length());
+  };
+  const std::vector<SiteSuffix>& index = GetSuffixIndex();
+  auto begin = std::lower_bound(
+      index.begin(), index.end(), input,
+      [&prefix](const SiteSuffix& suffix, const base::StringPiece& value) {
+        return prefix(suffix) < value;
+      });
+  auto end = std::upper_bound(
+      begin, index.end(), input,
+      [&prefix](const base::StringPiece& value, const SiteSuffix& suffix) {
+        return value < prefix(suffix);
+      });
+
+  std::vector<std::pair<size_t, size_t>> sites;
+  if (!max_matches)
+    return sites;
+
+  // Short inputs match more suffixes than there are sites. Those match many
+  // sites too, so scanning the list stops after a few of them and is cheaper.
+  if (static_cast<size_t>(end - begin) > top_sites_.size()) {
+    for (size_t site = 0;
+         site < top_sites_.size() && sites.size() < max_matches; ++site) {
+      const size_t pos = top_sites_[site].find(input_text);
+      if (pos != std::string::npos)
+        sites.emplace_back(site, pos);
+    }
+    return sites;
+  }
+
+  // The first |max_matches| sites in list order seen so far, with their first
+  // match position, as a max-heap on the site index: a site later in the list
+  // than all of them is skipped right away once the heap is full.
+  for (auto it = begin; it != end; ++it) {
+    if (sites.size() == max_matches && it->first > sites.front().first)
+      continue;
+    auto site = std::find_if(sites.begin(), sites.end(),
+                             [&it](const std::pair<size_t, size_t>& found) {
+                               return found.first == it->first;
+                             });
+    if (site != sites.end()) {
+      // Site indexes are unique in the heap, so this keeps it ordered.
+      site->second = std::min(site->second, it->second);
+      continue;
+    }
+    if (sites.size() == max_matches) {
+      std::pop_heap(sites.begin(), sites.end());
+      sites.pop_back();
+    }
+    sites.push_back(*it);
+    std::push_heap(sites.begin(), sites.end());
+  }
+  std::sort_heap(sites.begin(), sites.end());
+  return sites;
+}
+
 // static
 ACMatchClassifications TopSitesProvider::StylesForSingleMatch(
     const std::string &input_text,
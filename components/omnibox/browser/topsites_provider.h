@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_OMNIBOX_BROWSER_TOPSITES_PROVIDER_H_
 #define COMPONENTS_OMNIBOX_BROWSER_TOPSITES_PROVIDER_H_
 
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "base/compiler_specific.h"
@@ -30,6 +32,18 @@ class TopSitesProvider : public AutocompleteProvider {
 
   static std::vector<std::string> top_sites_;
 
+  // A suffix of a top site: (index in |top_sites_|, offset in the site).
+  using SiteSuffix = std::pair<size_t, size_t>;
+
+  // All suffixes of |top_sites_| in lexicographic order, built on first use.
+  static const std::vector<SiteSuffix>& GetSuffixIndex();
+
+  // Returns up to |max_matches| (index in |top_sites_|, position of the first
+  // occurrence) pairs for the sites containing |input_text|, in list order.
+  static std::vector<std::pair<size_t, size_t>> FindSites(
+      const std::string& input_text,
+      size_t max_matches);
+
   void AddMatch(const base::string16& match_string,
                 const ACMatchClassifications& styles);
 
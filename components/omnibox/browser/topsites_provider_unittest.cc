@@ -42,3 +42,37 @@ TEST_F(TopSitesProviderTest, SmokeTest) {
   provider_->Start(CreateAutocompleteInput("테스트"), false);
   EXPECT_TRUE(provider_->matches().empty());
 }
+
+// Checks that matches keep the top sites order and highlight the first
+// occurrence of the input.
+TEST_F(TopSitesProviderTest, MatchesInListOrder) {
+  provider_->Start(CreateAutocompleteInput("google"), false);
+  const ACMatches& matches = provider_->matches();
+  ASSERT_GE(matches.size(), 3u);
+  EXPECT_EQ(base::ASCIIToUTF16("google.com"), matches[0].contents);
+  EXPECT_EQ(base::ASCIIToUTF16("mail.google.com"), matches[1].contents);
+  EXPECT_EQ(base::ASCIIToUTF16("maps.google.com"), matches[2].contents);
+  EXPECT_GT(matches[0].relevance, matches[1].relevance);
+
+  ASSERT_EQ(3u, matches[1].contents_class.size());
+  EXPECT_EQ(5u, matches[1].contents_class[1].offset);
+  EXPECT_EQ(11u, matches[1].contents_class[2].offset);
+
+  provider_->Start(CreateAutocompleteInput("brave.co"), false);
+  ASSERT_EQ(1u, provider_->matches().size());
+  EXPECT_EQ(base::ASCIIToUTF16("brave.com"),
+            provider_->matches()[0].contents);
+}
+
+// Checks that sites containing the input several times are only matched once,
+// at their first occurrence, and that later sites don't push out earlier ones.
+TEST_F(TopSitesProviderTest, RepeatedOccurrences) {
+  provider_->Start(CreateAutocompleteInput("o"), false);
+  const ACMatches& matches = provider_->matches();
+  ASSERT_GE(matches.size(), 2u);
+  EXPECT_EQ(base::ASCIIToUTF16("google.com"), matches[0].contents);
+  EXPECT_EQ(base::ASCIIToUTF16("gmail.com"), matches[1].contents);
+  ASSERT_EQ(3u, matches[0].contents_class.size());
+  EXPECT_EQ(1u, matches[0].contents_class[1].offset);
+  EXPECT_EQ(2u, matches[0].contents_class[2].offset);
+}
@@ -20,6 +20,9 @@ constexpr char kLogValueKey[] = "value";
 constexpr char kLogSentKey[] = "sent";
 constexpr char kLogTimestampKey[] = "timestamp";
 
+// Value updates are coalesced over this interval before hitting local state.
+constexpr base::TimeDelta kFlushDelay = base::TimeDelta::FromSeconds(30);
+
 void RecordP3A(uint64_t answers_count) {
   int answer = 0;
   if (1 <= answers_count && answers_count < 5) {
@@ -56,29 +59,26 @@ void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
     unsent_entries_.insert(histogram_name);
   }
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  // The persistent value is updated later together with other changes.
+  MarkDirty(histogram_name);
+  if (!flush_timer_.IsRunning()) {
+    flush_timer_.Start(FROM_HERE, kFlushDelay, this,
+                       &BraveP3ALogStore::Flush);
+  }
 }
 
 void BraveP3ALogStore::ResetUploadStamps() {
   // Clear log entries flags.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
   for (auto& pair : log_) {
     if (pair.second.sent) {
       DCHECK(!pair.second.sent_timestamp.is_null());
       DCHECK(!unsent_entries_.contains(pair.first));
 
       pair.second.ResetSentState();
-
-      // Update persistent values.
-      update->SetPath({pair.first, kLogSentKey}, base::Value(pair.second.sent));
-      update->SetPath({pair.first, kLogTimestampKey},
-                      base::Value(pair.second.sent_timestamp.ToDoubleT()));
+      MarkDirty(pair.first);
     }
   }
+  Flush();
 
   RecordP3A(log_.size() - unsent_entries_.size());
 
@@ -137,12 +137,9 @@ void BraveP3ALogStore::DiscardStagedLog() {
   DCHECK(log_iter != log_.end());
   log_iter->second.MarkAsSent();
 
-  // Update the persistent value.
-  DictionaryPrefUpdate update(local_state_, kPrefName);
-  update->SetPath({log_iter->first, kLogSentKey},
-                  base::Value(log_iter->second.sent));
-  update->SetPath({log_iter->first, kLogTimestampKey},
-                  base::Value(log_iter->second.sent_timestamp.ToDoubleT()));
+  // Persist right away, so the value is not sent again after a restart.
+  MarkDirty(log_iter->first);
+  Flush();
 
   // Erase the entry from the unsent queue.
   auto unsent_entries_iter = unsent_entries_.find(staged_entry_key_);
@@ -153,6 +150,30 @@ void BraveP3ALogStore::DiscardStagedLog() {
   staged_log_.clear();
 }
 
+void BraveP3ALogStore::MarkDirty(const std::string& histogram_name) {
+  dirty_entries_.insert(histogram_name);
+}
+
+void BraveP3ALogStore::Flush() {
+  flush_timer_.Stop();
+  if (dirty_entries_.empty()) {
+    return;
+  }
+
+  DictionaryPrefUpdate update(local_state_, kPrefName);
+  for (const std::string& name : dirty_entries_) {
+    auto iter = log_.find(name);
+    DCHECK(iter != log_.end());
+    const LogEntry& entry = iter->second;
+    update->SetPath({name, kLogValueKey},
+                    base::Value(base::NumberToString(entry.value)));
+    update->SetPath({name, kLogSentKey}, base::Value(entry.sent));
+    update->SetPath({name, kLogTimestampKey},
+                    base::Value(entry.sent_timestamp.ToDoubleT()));
+  }
+  dirty_entries_.clear();
+}
+
 void BraveP3ALogStore::PersistUnsentLogs() const {
   NOTREACHED();
 }
@@ -12,6 +12,7 @@
 #include "base/containers/flat_set.h"
 #include "base/strings/string_piece.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/metrics/log_store.h"
 
 class PrefService;
@@ -19,7 +20,10 @@ class PrefRegistrySimple;
 
 namespace brave {
 
-// Stores all given values in memory and persists in prefs on the fly.
+// Stores all given values in memory and persists changed entries in prefs
+// in batches: value updates are written after a short delay, sent state
+// changes immediately. |Flush()| has to be called at shutdown to write the
+// pending updates.
 // All logs (not only unsent are persistent), and all logs could be loaded
 // using |LoadPersistedUnsentLogs()|. We should fix this at some point since
 // for now persisted entries never expire.
@@ -42,6 +46,8 @@ class BraveP3ALogStore : public metrics::LogStore {
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
   void UpdateValue(const std::string& histogram_name, uint64_t value);
+  // Writes all pending updates to prefs in one update.
+  void Flush();
   // Marks all saved values as unsent.
   void ResetUploadStamps();
 
@@ -55,7 +61,7 @@ class BraveP3ALogStore : public metrics::LogStore {
   void DiscardStagedLog() override;
 
   // |PersistUnsentLogs| should not be used, since we persist everything
-  // on the fly.
+  // ourselves.
   void PersistUnsentLogs() const override;
   // Returns early if founds malformed persisted values.
   void LoadPersistedUnsentLogs() override;
@@ -78,12 +84,18 @@ class BraveP3ALogStore : public metrics::LogStore {
     base::Time sent_timestamp;  // At the moment only for debugging purposes.
   };
 
+  // Remembers that |histogram_name| has to be written to prefs.
+  void MarkDirty(const std::string& histogram_name);
+
   const LogSerializer* const serializer_ = nullptr;  // Weak.
   PrefService* const local_state_ = nullptr;
 
   // TODO(iefremov): Try to replace with base::StringPiece?
   base::flat_map<std::string, LogEntry> log_;
   base::flat_set<std::string> unsent_entries_;
+  // Entries changed since the last |Flush()|.
+  base::flat_set<std::string> dirty_entries_;
+  base::OneShotTimer flush_timer_;
 
   std::string staged_entry_key_;
   std::string staged_log_;
@@ -32,6 +32,7 @@
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/metrics_proto/reporting_info.pb.h"
 
@@ -185,6 +186,13 @@ void BraveP3AService::Init() {
   }
 }
 
+void BraveP3AService::Flush() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (log_store_) {
+    log_store_->Flush();
+  }
+}
+
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
                                        uint64_t value) const {
   // TRACE_EVENT0("brave_p3a", "SerializeMessage");
@@ -305,21 +313,36 @@ void BraveP3AService::OnHistogramChanged(base::StringPiece histogram_name,
     return;
   }
 
+  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
+          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    pending_histogram_values_[histogram_name] = bucket;
+    if (histograms_update_posted_) {
+      return;
+    }
+    histograms_update_posted_ = true;
+  }
+
   base::PostTaskWithTraits(
       FROM_HERE, {content::BrowserThread::UI},
-      base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                     histogram_name, sample, bucket));
+      base::BindOnce(&BraveP3AService::OnHistogramsChangedOnUI, this));
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
-  if (!initialized_) {
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    log_store_->UpdateValue(histogram_name.as_string(), bucket);
+void BraveP3AService::OnHistogramsChangedOnUI() {
+  base::flat_map<base::StringPiece, size_t> values;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    values.swap(pending_histogram_values_);
+    histograms_update_posted_ = false;
+  }
+
+  for (const auto& entry : values) {
+    if (!initialized_) {
+      histogram_values_[entry.first] = entry.second;
+    } else {
+      log_store_->UpdateValue(entry.first.as_string(), entry.second);
+    }
   }
 }
 
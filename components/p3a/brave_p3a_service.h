@@ -12,6 +12,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_base.h"
+#include "base/synchronization/lock.h"
 #include "base/timer/timer.h"
 #include "brave/components/brave_prochlo/brave_prochlo_message.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
@@ -42,6 +43,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // Needs a living browser process to complete the initialization.
   void Init();
 
+  // Writes the pending values to local state. Called on UI thread at shutdown,
+  // before local state is committed for the last time.
+  void Flush();
+
   // BraveP3ALogStore::LogSerializer
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value) const override;
@@ -57,13 +62,12 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void StartScheduledUpload();
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method collects the latest bucket of each
+  // histogram and reposts them to UI thread in batches.
   void OnHistogramChanged(base::StringPiece histogram_name,
                           base::HistogramBase::Sample sample);
 
-  void OnHistogramChangedOnUI(base::StringPiece histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  void OnHistogramsChangedOnUI();
 
   void OnLogUploadComplete(int response_code, int error_code, bool was_https);
 
@@ -94,6 +98,13 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   // the service and its initialization.
   base::flat_map<base::StringPiece, size_t> histogram_values_;
 
+  // Buckets recorded on any thread that are not handled on UI thread yet.
+  // Only the latest bucket of a histogram matters, so repeated samples
+  // overwrite each other and only one UI task is posted per batch.
+  base::Lock pending_histogram_values_lock_;
+  base::flat_map<base::StringPiece, size_t> pending_histogram_values_;
+  bool histograms_update_posted_ = false;
+
   // Once fired we restart the overall uploading process.
   base::OneShotTimer rotation_timer_;
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/bind_helpers.h"
+#include "base/no_destructor.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "brave/common/render_messages.h"
@@ -58,6 +59,9 @@ void BraveContentSettingsObserver::DidCommitProvisionalLoad(
   if (!is_same_document_navigation) {
     temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+    shields_down_cache_.clear();
+    fingerprinting_cache_.clear();
+    script_source_cache_.clear();
   }
 
   ContentSettingsObserver::DidCommitProvisionalLoad(
@@ -111,19 +115,36 @@ bool BraveContentSettingsObserver::AllowScriptFromSource(
     const blink::WebURL& script_url) {
   const GURL secondary_url(script_url);
 
-  bool allow = ContentSettingsObserver::AllowScriptFromSource(
-      enabled_per_settings, script_url);
-
-  // scripts with whitelisted protocols, such as chrome://extensions should
-  // be allowed
-  bool should_white_list = IsWhitelistedForContentSettings(
-      blink::WebSecurityOrigin::Create(script_url),
-      render_frame()->GetWebFrame()->GetDocument().Url());
+  // Every check below only depends on the origin of http(s) scripts, so pages
+  // loading many scripts from a few origins only evaluate each origin once.
+  std::string cache_key;
+  if (enabled_per_settings && content_setting_rules_ &&
+      secondary_url.SchemeIsHTTPOrHTTPS()) {
+    cache_key = secondary_url.GetOrigin().spec();
+  }
 
-  allow = allow ||
-    should_white_list ||
-    IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
-    IsScriptTemporilyAllowed(secondary_url);
+  bool allow = false;
+  auto it = script_source_cache_.find(cache_key);
+  if (!cache_key.empty() && it != script_source_cache_.end()) {
+    allow = it->second;
+  } else {
+    allow = ContentSettingsObserver::AllowScriptFromSource(
+        enabled_per_settings, script_url);
+
+    // scripts with whitelisted protocols, such as chrome://extensions should
+    // be allowed
+    bool should_white_list = IsWhitelistedForContentSettings(
+        blink::WebSecurityOrigin::Create(script_url),
+        render_frame()->GetWebFrame()->GetDocument().Url());
+
+    allow = allow ||
+      should_white_list ||
+      IsBraveShieldsDown(render_frame()->GetWebFrame(), secondary_url) ||
+      IsScriptTemporilyAllowed(secondary_url);
+
+    if (!cache_key.empty())
+      script_source_cache_[cache_key] = allow;
+  }
 
   if (!allow) {
     blocked_script_url_ = secondary_url;
@@ -154,19 +175,18 @@ ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
     const ContentSettingsForOneType& rules,
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-
-  if (rules.size() == 0)
-    return CONTENT_SETTING_DEFAULT;
+  static const base::NoDestructor<ContentSettingsPattern> kFirstPartyPattern(
+      ContentSettingsPattern::FromString("https://firstParty/*"));
 
   const GURL& primary_url = GetOriginOrURL(frame);
+  const ContentSettingsPattern first_party_pattern =
+      ContentSettingsPattern::FromString("[*.]" + primary_url.HostNoBrackets());
 
   for (const auto& rule : rules) {
-    ContentSettingsPattern secondary_pattern = rule.secondary_pattern;
-    if (rule.secondary_pattern ==
-        ContentSettingsPattern::FromString("https://firstParty/*")) {
-      secondary_pattern = ContentSettingsPattern::FromString(
-          "[*.]" + GetOriginOrURL(frame).HostNoBrackets());
-    }
+    const ContentSettingsPattern& secondary_pattern =
+        rule.secondary_pattern == *kFirstPartyPattern
+            ? first_party_pattern
+            : rule.secondary_pattern;
 
     if (rule.primary_pattern.Matches(primary_url) &&
         (secondary_pattern == ContentSettingsPattern::Wildcard() ||
@@ -175,6 +195,10 @@ ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
     }
   }
 
+  // The default rule allows first party resources.
+  if (first_party_pattern.Matches(secondary_url))
+    return CONTENT_SETTING_ALLOW;
+
   // for cases which are third party resources and doesn't match any existing
   // rules, block them by default
   return CONTENT_SETTING_BLOCK;
@@ -183,20 +207,35 @@ ContentSetting BraveContentSettingsObserver::GetFPContentSettingFromRules(
 bool BraveContentSettingsObserver::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
+  if (!content_setting_rules_)
+    return false;
+
+  // Patterns only look at the origin of http(s) URLs, so the result can be
+  // reused for all URLs of the same origin.
+  std::string cache_key;
+  if (frame == render_frame()->GetWebFrame() &&
+      secondary_url.SchemeIsHTTPOrHTTPS()) {
+    cache_key = secondary_url.GetOrigin().spec();
+    auto it = shields_down_cache_.find(cache_key);
+    if (it != shields_down_cache_.end())
+      return it->second;
+  }
+
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   const GURL& primary_url = GetOriginOrURL(frame);
 
-  if (content_setting_rules_) {
-    for (const auto& rule : content_setting_rules_->brave_shields_rules) {
-      if (rule.primary_pattern.Matches(primary_url) &&
-          rule.secondary_pattern.Matches(secondary_url)) {
-        setting = rule.GetContentSetting();
-        break;
-      }
+  for (const auto& rule : content_setting_rules_->brave_shields_rules) {
+    if (rule.primary_pattern.Matches(primary_url) &&
+        rule.secondary_pattern.Matches(secondary_url)) {
+      setting = rule.GetContentSetting();
+      break;
     }
   }
 
-  return setting == CONTENT_SETTING_BLOCK;
+  const bool shields_down = setting == CONTENT_SETTING_BLOCK;
+  if (!cache_key.empty())
+    shields_down_cache_[cache_key] = shields_down;
+  return shields_down;
 }
 
 bool BraveContentSettingsObserver::AllowFingerprinting(
@@ -206,6 +245,29 @@ bool BraveContentSettingsObserver::AllowFingerprinting(
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
   const GURL secondary_url(
       url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL());
+
+  // Fingerprinting APIs can be probed thousands of times per page, so the
+  // rules are only evaluated once per origin for the current document.
+  bool allow = false;
+  auto it = fingerprinting_cache_.find(secondary_url.spec());
+  if (it != fingerprinting_cache_.end()) {
+    allow = it->second;
+  } else {
+    allow = GetFingerprintingDecision(frame, secondary_url);
+    if (content_setting_rules_)
+      fingerprinting_cache_[secondary_url.spec()] = allow;
+  }
+
+  if (!allow) {
+    DidBlockFingerprinting(base::UTF8ToUTF16(secondary_url.spec()));
+  }
+
+  return allow;
+}
+
+bool BraveContentSettingsObserver::GetFingerprintingDecision(
+    const blink::WebFrame* frame,
+    const GURL& secondary_url) {
   if (IsBraveShieldsDown(frame, secondary_url)) {
     return true;
   }
@@ -213,28 +275,16 @@ bool BraveContentSettingsObserver::AllowFingerprinting(
   if (brave::IsWhitelistedFingerprintingException(primary_url, secondary_url)) {
     return true;
   }
-  ContentSettingsForOneType rules;
-  if (content_setting_rules_) {
-      rules = content_setting_rules_->fingerprinting_rules;
-  }
-  ContentSettingPatternSource default_rule = ContentSettingPatternSource(
-      ContentSettingsPattern::Wildcard(),
-      ContentSettingsPattern::FromString("https://firstParty/*"),
-      base::Value::FromUniquePtrValue(
-          content_settings::ContentSettingToValue(CONTENT_SETTING_ALLOW)),
-      std::string(), false);
-  rules.push_back(default_rule);
+
+  // Both branches are references so the rules are not copied.
+  static const base::NoDestructor<ContentSettingsForOneType> kNoRules;
+  const ContentSettingsForOneType& rules =
+      content_setting_rules_ ? content_setting_rules_->fingerprinting_rules
+                             : *kNoRules;
   ContentSetting setting =
       GetFPContentSettingFromRules(rules, frame, secondary_url);
-  rules.pop_back();
-  bool allow = setting != CONTENT_SETTING_BLOCK;
-  allow = allow || IsWhitelistedForContentSettings();
-
-  if (!allow) {
-    DidBlockFingerprinting(base::UTF8ToUTF16(secondary_url.spec()));
-  }
-
-  return allow;
+  return setting != CONTENT_SETTING_BLOCK ||
+         IsWhitelistedForContentSettings();
 }
 
 bool BraveContentSettingsObserver::AllowAutoplay(bool default_value) {
@@ -5,6 +5,9 @@
 #ifndef BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 #define BRAVE_RENDERER_CONTENT_SETTINGS_OBSERVER_H_
 
+#include <string>
+
+#include "base/containers/flat_map.h"
 #include "base/strings/string16.h"
 #include "chrome/renderer/content_settings_observer.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -51,6 +54,10 @@ class BraveContentSettingsObserver
       const blink::WebFrame* frame,
       const GURL& secondary_url);
 
+  // Evaluates the fingerprinting rules, without the per-document cache.
+  bool GetFingerprintingDecision(const blink::WebFrame* frame,
+                                 const GURL& secondary_url);
+
   // RenderFrameObserver
   bool OnMessageReceived(const IPC::Message& message) override;
   void OnAllowScriptsOnce(const std::vector<std::string>& origins);
@@ -69,6 +76,16 @@ class BraveContentSettingsObserver
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Results of |IsBraveShieldsDown()| and |AllowFingerprinting()| for the
+  // current document, keyed by origin. Like the upstream script permission
+  // cache they live until the next cross-document commit, which is also when
+  // the frame picks up rules changed by a shields toggle and reload.
+  base::flat_map<std::string, bool> shields_down_cache_;
+  base::flat_map<std::string, bool> fingerprinting_cache_;
+  // Results of |AllowScriptFromSource()| for the current document, keyed by
+  // script origin.
+  base::flat_map<std::string, bool> script_source_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsObserver);
 };
 
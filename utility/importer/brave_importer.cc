@@ -160,6 +160,10 @@ void BraveImporter::ImportHistory() {
     row.typed_count = 0;
 
     rows.push_back(row);
+    if (rows.size() >= kHistoryRowsPerChunk) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_BRAVE_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -9,12 +9,16 @@
 #include <string>
 #include <utility>
 
+#include "base/barrier_closure.h"
+#include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task/post_task.h"
 #include "base/values.h"
 #include "brave/utility/importer/brave_external_process_importer_bridge.h"
 #include "build/build_config.h"
@@ -127,6 +131,10 @@ void ChromeImporter::ImportHistory() {
     row.visit_count = s.ColumnInt(4);
 
     rows.push_back(row);
+    if (rows.size() >= kHistoryRowsPerChunk) {
+      bridge_->SetHistoryItems(rows, importer::VISIT_SOURCE_CHROME_IMPORTED);
+      rows.clear();
+    }
   }
 
   if (!rows.empty() && !cancelled())
@@ -134,13 +142,16 @@ void ChromeImporter::ImportHistory() {
 }
 
 void ChromeImporter::ImportBookmarks() {
-  std::string bookmarks_content;
-  base::FilePath bookmarks_path =
-    source_path_.Append(
-      base::FilePath::StringType(FILE_PATH_LITERAL("Bookmarks")));
-  base::ReadFileToString(bookmarks_path, &bookmarks_content);
-  base::Optional<base::Value> bookmarks_json =
-    base::JSONReader::Read(bookmarks_content);
+  base::Optional<base::Value> bookmarks_json;
+  {
+    // Only keep the parsed tree, the file contents are not needed anymore.
+    std::string bookmarks_content;
+    base::FilePath bookmarks_path =
+      source_path_.Append(
+        base::FilePath::StringType(FILE_PATH_LITERAL("Bookmarks")));
+    base::ReadFileToString(bookmarks_path, &bookmarks_content);
+    bookmarks_json = base::JSONReader::Read(bookmarks_content);
+  }
   const base::DictionaryValue* bookmark_dict;
   if (!bookmarks_json || !bookmarks_json->GetAsDictionary(&bookmark_dict))
     return;
@@ -174,6 +185,7 @@ void ChromeImporter::ImportBookmarks() {
       base::UTF8ToUTF16("Imported from Chrome");
     bridge_->AddBookmarks(bookmarks, first_folder_name);
   }
+  bookmarks_json.reset();
 
   // Import favicons.
   base::FilePath favicons_path =
@@ -189,11 +201,8 @@ void ChromeImporter::ImportBookmarks() {
   FaviconMap favicon_map;
   ImportFaviconURLs(&db, &favicon_map);
   // Write favicons into profile.
-  if (!favicon_map.empty() && !cancelled()) {
-    favicon_base::FaviconUsageDataList favicons;
-    LoadFaviconData(&db, favicon_map, &favicons);
-    bridge_->SetFavicons(favicons);
-  }
+  if (!favicon_map.empty() && !cancelled())
+    LoadFaviconData(&db, favicon_map);
 }
 
 void ChromeImporter::ImportFaviconURLs(
@@ -211,41 +220,85 @@ void ChromeImporter::ImportFaviconURLs(
 
 void ChromeImporter::LoadFaviconData(
     sql::Database* db,
-    const FaviconMap& favicon_map,
-    favicon_base::FaviconUsageDataList* favicons) {
-  const char query[] = "SELECT f.url, fb.image_data "
+    const FaviconMap& favicon_map) {
+  // Read all the bitmaps in one pass, in the same order as |favicon_map|.
+  const char query[] = "SELECT f.id, f.url, fb.image_data "
                        "FROM favicons f "
                        "JOIN favicon_bitmaps fb "
                        "ON f.id = fb.icon_id "
-                       "WHERE f.id = ?;";
+                       "ORDER BY f.id, fb.id;";
   sql::Statement s(db->GetUniqueStatement(query));
 
   if (!s.is_valid())
     return;
 
-  for (FaviconMap::const_iterator i = favicon_map.begin();
-       i != favicon_map.end(); ++i) {
-    s.BindInt64(0, i->first);
-    if (s.Step()) {
-      favicon_base::FaviconUsageData usage;
-
-      usage.favicon_url = GURL(s.ColumnString(0));
-      if (!usage.favicon_url.is_valid())
-        continue;  // Don't bother importing favicons with invalid URLs.
+  std::vector<PendingFavicon> batch;
+  int64_t last_icon_id = -1;
+  while (s.Step() && !cancelled()) {
+    // Only the first bitmap of each icon is imported.
+    int64_t icon_id = s.ColumnInt64(0);
+    if (icon_id == last_icon_id)
+      continue;
+    last_icon_id = icon_id;
+
+    FaviconMap::const_iterator i = favicon_map.find(icon_id);
+    if (i == favicon_map.end())
+      continue;
+
+    PendingFavicon favicon;
+    favicon.usage.favicon_url = GURL(s.ColumnString(1));
+    if (!favicon.usage.favicon_url.is_valid())
+      continue;  // Don't bother importing favicons with invalid URLs.
+
+    s.ColumnBlobAsVector(2, &favicon.data);
+    if (favicon.data.empty())
+      continue;  // Data definitely invalid.
+
+    favicon.usage.urls = i->second;
+    batch.push_back(std::move(favicon));
+    if (batch.size() >= kFaviconsPerBatch) {
+      ReencodeAndSendFavicons(&batch);
+      batch.clear();
+    }
+  }
 
-      std::vector<unsigned char> data;
-      s.ColumnBlobAsVector(1, &data);
-      if (data.empty())
-        continue;  // Data definitely invalid.
+  if (!batch.empty() && !cancelled())
+    ReencodeAndSendFavicons(&batch);
+}
 
-      if (!importer::ReencodeFavicon(&data[0], data.size(), &usage.png_data))
-        continue;  // Unable to decode.
+void ChromeImporter::ReencodeAndSendFavicons(
+    std::vector<PendingFavicon>* batch) {
+  // Decoding dominates the favicon import, so the batch is re-encoded on the
+  // thread pool while this thread waits.
+  base::WaitableEvent done;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      batch->size(),
+      base::BindOnce(&base::WaitableEvent::Signal, base::Unretained(&done)));
+  for (PendingFavicon& favicon : *batch) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::ThreadPool(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&ReencodePendingFavicon, base::Unretained(&favicon),
+                       barrier));
+  }
+  done.Wait();
 
-      usage.urls = i->second;
-      favicons->push_back(usage);
-    }
-    s.Reset(true);
+  favicon_base::FaviconUsageDataList favicons;
+  for (PendingFavicon& favicon : *batch) {
+    if (favicon.reencoded)
+      favicons.push_back(std::move(favicon.usage));
   }
+  if (!favicons.empty() && !cancelled())
+    bridge_->SetFavicons(favicons);
+}
+
+// static
+void ChromeImporter::ReencodePendingFavicon(PendingFavicon* favicon,
+                                            base::OnceClosure done) {
+  favicon->reencoded = importer::ReencodeFavicon(
+      &favicon->data[0], favicon->data.size(), &favicon->usage.png_data);
+  // The raw bitmap is not needed anymore.
+  favicon->data = std::vector<unsigned char>();
+  std::move(done).Run();
 }
 
 void ChromeImporter::RecursiveReadBookmarksFolder(
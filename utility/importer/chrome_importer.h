@@ -11,6 +11,7 @@
 #include <set>
 #include <vector>
 
+#include "base/callback_forward.h"
 #include "base/compiler_specific.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
@@ -50,6 +51,10 @@ class ChromeImporter : public Importer {
 
   double chromeTimeToDouble(int64_t time);
 
+  // History rows are sent to the browser in chunks of this size, so neither
+  // process holds the whole history of a large profile at once.
+  static constexpr size_t kHistoryRowsPerChunk = 1000;
+
   base::FilePath source_path_;
 
  private:
@@ -58,15 +63,28 @@ class ChromeImporter : public Importer {
   // actually loading the icons.
   typedef std::map<int64_t, std::set<GURL>> FaviconMap;
 
+  // A favicon read from the profile, waiting to be re-encoded.
+  struct PendingFavicon {
+    favicon_base::FaviconUsageData usage;
+    std::vector<unsigned char> data;
+    bool reencoded = false;
+  };
+
   // Loads the urls associated with the favicons into favicon_map;
   void ImportFaviconURLs(
     sql::Database* db,
     FaviconMap* favicon_map);
 
-  // Loads and reencodes the individual favicons.
-  void LoadFaviconData(sql::Database* db,
-                       const FaviconMap& favicon_map,
-                       favicon_base::FaviconUsageDataList* favicons);
+  // Loads and reencodes the individual favicons, and sends them to the bridge
+  // in batches of |kFaviconsPerBatch|.
+  void LoadFaviconData(sql::Database* db, const FaviconMap& favicon_map);
+  void ReencodeAndSendFavicons(std::vector<PendingFavicon>* batch);
+  // Runs on the thread pool.
+  static void ReencodePendingFavicon(PendingFavicon* favicon,
+                                     base::OnceClosure done);
+
+  // Bounds the number of raw and re-encoded favicons held at once.
+  static constexpr size_t kFaviconsPerBatch = 256;
 
   void RecursiveReadBookmarksFolder(
     const base::DictionaryValue* folder,